@@ -0,0 +1,648 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+//////////////////////////////// OS Nuetral Headers ////////////////
+#include "OISInputManager.h"
+#include "OISException.h"
+#include "OISKeyboard.h"
+#include "OISJoyStick.h"
+#include "OISVirtual.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+////////////////////////////////////Needed Linux Headers//////////////
+#if defined OIS_LINUX_PLATFORM
+#include "linux/LinuxJoyStickEvents.h"
+#include "linux/LinuxKeyboard.h"
+#include <X11/keysym.h>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+#include "UInputJoyStick.h"
+#endif
+//////////////////////////////////////////////////////////////////////
+
+using namespace OIS;
+
+//-- Allocation counting: every operator new in the process (OIS included) goes through here --//
+//The complete replaceable set (plain, array, nothrow and sized) is routed through one allocate/release
+//pair. release is kept out of line, otherwise GCC inlines it into callers and reports the free() of
+//a pointer that came from operator new as a mismatch (-Wmismatched-new-delete).
+#if defined(__GNUC__)
+#define BENCH_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE
+#endif
+
+static unsigned long long g_Allocations = 0;
+
+static void* allocate(std::size_t size) noexcept
+{
+	++g_Allocations;
+	return std::malloc(size ? size : 1);
+}
+
+static BENCH_NOINLINE void release(void* p) noexcept
+{
+	std::free(p);
+}
+
+void* operator new(std::size_t size)
+{
+	if(void* p = allocate(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	if(void* p = allocate(size))
+		return p;
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	release(p);
+}
+
+//-- Harness --//
+//Optional substring filter from the command line
+static const char* g_Filter = 0;
+
+//Runs setup (untimed) and body (timed) until 0.2s of body time is collected, then reports per event figures
+template <typename Setup, typename Body>
+void runBenchmark(const char* name, unsigned int eventsPerIteration, Setup setup, Body body)
+{
+	if(g_Filter && std::strstr(name, g_Filter) == 0)
+		return;
+
+	typedef std::chrono::steady_clock Clock;
+	const std::chrono::nanoseconds minTime = std::chrono::milliseconds(200);
+
+	//Warm up, so one time allocations (reserved buffers etc) are not counted
+	setup();
+	body();
+
+	std::chrono::nanoseconds elapsed(0);
+	unsigned long long iterations  = 0;
+	unsigned long long allocations = 0;
+	while(elapsed < minTime || iterations < 10)
+	{
+		setup();
+		unsigned long long allocsBefore = g_Allocations;
+		Clock::time_point start			= Clock::now();
+		body();
+		elapsed += Clock::now() - start;
+		allocations += g_Allocations - allocsBefore;
+		++iterations;
+	}
+
+	double events = (double)iterations * eventsPerIteration;
+	std::printf("%-40s %12.2f ns/event %10.3f allocs/event %12llu events\n",
+				name, (double)elapsed.count() / events, (double)allocations / events, (unsigned long long)events);
+}
+
+static void noSetup() { }
+
+//Number of failed BENCH_CHECKs, makes the exit code non zero
+static int g_Failures = 0;
+
+#define BENCH_CHECK(cond)                                                           \
+	OIS_MACRO_BEGIN                                                                 \
+	if(!(cond))                                                                     \
+	{                                                                               \
+		std::printf("CHECK FAILED: %s (%s:%d)\n", #cond, __FILE__, __LINE__); \
+		++g_Failures;                                                               \
+	}                                                                               \
+	OIS_MACRO_END
+
+static void skipBenchmark(const char* name, const char* reason)
+{
+	if(g_Filter == 0 || std::strstr(name, g_Filter) != 0)
+		std::printf("%-40s skipped (%s)\n", name, reason);
+}
+
+//-- Listeners which do as little as possible, so the cost measured is OIS' --//
+class NullKeyListener : public KeyListener
+{
+public:
+	bool keyPressed(const KeyEvent&) { return true; }
+	bool keyReleased(const KeyEvent&) { return true; }
+};
+
+class NullMouseListener : public MouseListener
+{
+public:
+	bool mouseMoved(const MouseEvent&) { return true; }
+	bool mousePressed(const MouseEvent&, MouseButtonID) { return true; }
+	bool mouseReleased(const MouseEvent&, MouseButtonID) { return true; }
+};
+
+class NullJoyStickListener : public JoyStickListener
+{
+public:
+	bool buttonPressed(const JoyStickEvent&, int) { return true; }
+	bool buttonReleased(const JoyStickEvent&, int) { return true; }
+	bool axisMoved(const JoyStickEvent&, int) { return true; }
+};
+
+#if defined OIS_LINUX_PLATFORM
+//Exposes the protected keysym lookup, using a display connection without any window
+class BenchKeyboard : public LinuxKeyboard
+{
+public:
+	BenchKeyboard(InputManager* creator, Display* disp) :
+	 LinuxKeyboard(creator, false, false)
+	{
+		display = disp;
+		_refreshKeyMap();
+	}
+
+	~BenchKeyboard() { display = 0; }
+
+	OIS::KeyCode lookup(KeySym keySym) { return KeySymToOISKeyCode(keySym); }
+};
+
+//---------------------------------------------------------------------------------//
+static void benchJoyStickCapture(InputManager* im)
+{
+	//A fake evdev joystick reading from a pipe, without force feedback (so no _initialize)
+	int fds[2];
+	if(pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0)
+	{
+		skipBenchmark("JoyStick capture (pipe)", "no pipe");
+		return;
+	}
+
+	JoyStickInfo info;
+	info.joyFileD = fds[0];
+	info.vendor	  = "Bench";
+	info.buttons  = 8;
+	info.axes	  = 4;
+	for(int i = 0; i < 8; ++i)
+		info.button_map[BTN_GAMEPAD + i] = i;
+	for(int i = 0; i < 4; ++i)
+	{
+		info.axis_map[ABS_X + i] = i;
+		info.axis_range[i]		 = Range(0, 255);
+	}
+
+	LinuxJoyStick* joy = new LinuxJoyStick(im, true, info, false);
+	NullJoyStickListener listener;
+	joy->setEventCallback(&listener);
+
+	//One frame: 8 button changes, 4 axis moves and a SYN_REPORT
+	const int FRAME_EVENTS = 13;
+	const int FRAMES	   = 16;
+	input_event frames[FRAME_EVENTS * FRAMES];
+	std::memset(frames, 0, sizeof(frames));
+	for(int f = 0; f < FRAMES; ++f)
+	{
+		input_event* ev = &frames[f * FRAME_EVENTS];
+		for(int i = 0; i < 8; ++i)
+		{
+			ev[i].type	= EV_KEY;
+			ev[i].code	= BTN_GAMEPAD + i;
+			ev[i].value = (f + i) & 1;
+		}
+		for(int i = 0; i < 4; ++i)
+		{
+			ev[8 + i].type	= EV_ABS;
+			ev[8 + i].code	= ABS_X + i;
+			ev[8 + i].value = (f * 16 + i) & 255;
+		}
+		ev[12].type = EV_SYN;
+	}
+
+	runBenchmark(
+		"JoyStick capture (pipe)", FRAME_EVENTS * FRAMES,
+		[&]() {
+			if(write(fds[1], frames, sizeof(frames)) != (ssize_t)sizeof(frames))
+				std::abort();
+		},
+		[&]() { joy->capture(); });
+
+	delete joy;
+	close(fds[1]);
+}
+
+//---------------------------------------------------------------------------------//
+static void benchKeySymLookup(InputManager* im)
+{
+	Display* display = getenv("DISPLAY") ? XOpenDisplay(0) : 0;
+	if(display == 0)
+	{
+		skipBenchmark("KeySymToOISKeyCode", "no X display");
+		return;
+	}
+
+	BenchKeyboard* keyboard = new BenchKeyboard(im, display);
+
+	//Letters go through XKeysymToKeycode, the rest through the explicit conversion table
+	const KeySym keySyms[8] = { XK_a, XK_Up, XK_KP_Home, XK_Shift_L, XK_z, XK_F1, XK_Return, XK_KP_Divide };
+	volatile int sink		= 0;
+
+	runBenchmark("KeySymToOISKeyCode", 1024, noSetup, [&]() {
+		for(int i = 0; i < 1024; ++i)
+			sink = sink + keyboard->lookup(keySyms[i & 7]);
+	});
+
+	delete keyboard;
+	XCloseDisplay(display);
+}
+
+//---------------------------------------------------------------------------------//
+static std::uint64_t monotonicNs()
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (std::uint64_t)ts.tv_sec * 1000000000ULL + (std::uint64_t)ts.tv_nsec;
+}
+
+//Remembers when the last button event reached the application
+class LatencyListener : public JoyStickListener
+{
+public:
+	LatencyListener() :
+	 received(0) { }
+
+	bool buttonPressed(const JoyStickEvent&, int)
+	{
+		received = monotonicNs();
+		return true;
+	}
+
+	bool buttonReleased(const JoyStickEvent&, int)
+	{
+		received = monotonicNs();
+		return true;
+	}
+
+	bool axisMoved(const JoyStickEvent&, int) { return true; }
+
+	std::uint64_t received;
+};
+
+//---------------------------------------------------------------------------------//
+static void benchUInputJoyStick()
+{
+	//Runs through the real kernel path: uinput -> evdev node -> scan -> LinuxJoyStick
+	const char* name = "OIS Bench uinput pad";
+	const int BUTTONS = 20, AXES = 6, HATS = 1;
+	UInputJoyStick pad(name, BUTTONS, AXES, HATS, true);
+	if(!pad.valid())
+	{
+		skipBenchmark("uinput", "no write access to /dev/uinput");
+		return;
+	}
+
+	//The manager scans joysticks when created, so this has to happen after the pad exists
+	ParamList pl;
+	InputManager* im = InputManager::createInputSystem(pl);
+	JoyStick* joy	 = 0;
+	try
+	{
+		joy = static_cast<JoyStick*>(im->createInputObject(OISJoyStick, true, name));
+	}
+	catch(const Exception&)
+	{
+		InputManager::destroyInputSystem(im);
+		std::printf("CHECK FAILED: uinput pad \"%s\" was not found by the joystick scan\n", name);
+		++g_Failures;
+		return;
+	}
+
+	//Layout as seen by OIS
+	BENCH_CHECK(joy->getNumberOfComponents(OIS_Button) == BUTTONS);
+	BENCH_CHECK(joy->getNumberOfComponents(OIS_Axis) == AXES);
+	BENCH_CHECK(joy->getNumberOfComponents(OIS_POV) == HATS);
+
+	//State after one frame
+	pad.button(3, true);
+	pad.button(BUTTONS - 1, true);
+	pad.axis(1, 12345);
+	pad.axis(AXES - 1, -32768);
+	pad.hat(0, -1, -1);
+	pad.sync();
+	im->waitForInput(1000);
+
+	const JoyStickState& state = joy->getJoyStickState();
+	BENCH_CHECK(state.mButtons[3] && state.mButtons[BUTTONS - 1] && !state.mButtons[0]);
+	BENCH_CHECK(std::abs(state.mAxes[1].abs - 12345) <= 1); //Rescaling may round
+	BENCH_CHECK(state.mAxes[AXES - 1].abs == JoyStick::MIN_AXIS);
+	BENCH_CHECK(state.mPOV[0].direction == Pov::NorthWest);
+
+	//Latency from the write to the listener, one frame at a time
+	LatencyListener latency;
+	joy->setEventCallback(&latency);
+
+	const int SAMPLES = 1000;
+	std::vector<std::uint64_t> samples;
+	samples.reserve(SAMPLES);
+	for(int i = 0; i < SAMPLES; ++i)
+	{
+		latency.received   = 0;
+		std::uint64_t sent = monotonicNs();
+		pad.button(0, (i & 1) == 0);
+		pad.sync();
+
+		while(latency.received == 0 && im->waitForInput(100)) { }
+		if(latency.received)
+			samples.push_back(latency.received - sent);
+	}
+
+	BENCH_CHECK(samples.size() == (std::size_t)SAMPLES);
+	if(!samples.empty())
+	{
+		std::sort(samples.begin(), samples.end());
+		std::printf("%-40s %12.2f us p50 %10.2f us p99 %12u samples\n", "uinput write -> listener latency",
+					samples[samples.size() / 2] / 1000.0, samples[samples.size() * 99 / 100] / 1000.0, (unsigned int)samples.size());
+	}
+
+	//Throughput of capture() on real evdev frames
+	NullJoyStickListener listener;
+	joy->setEventCallback(&listener);
+
+	const int FRAME_EVENTS = BUTTONS + AXES + 1;
+	const int FRAMES	   = 8;
+	input_event frames[FRAME_EVENTS * FRAMES];
+	std::memset(frames, 0, sizeof(frames));
+	for(int f = 0; f < FRAMES; ++f)
+	{
+		input_event* ev = &frames[f * FRAME_EVENTS];
+		for(int i = 0; i < BUTTONS; ++i)
+		{
+			ev[i].type	= EV_KEY;
+			ev[i].code	= UInputJoyStick::buttonCode(i);
+			ev[i].value = (f + i) & 1;
+		}
+		for(int i = 0; i < AXES; ++i)
+		{
+			ev[BUTTONS + i].type  = EV_ABS;
+			ev[BUTTONS + i].code  = ABS_X + i;
+			ev[BUTTONS + i].value = f * 1000 + i;
+		}
+		ev[FRAME_EVENTS - 1].type = EV_SYN;
+	}
+
+	runBenchmark(
+		"JoyStick capture (uinput)", FRAME_EVENTS * FRAMES,
+		[&]() {
+			pad.emit(frames, FRAME_EVENTS * FRAMES);
+			usleep(1000);
+		},
+		[&]() { joy->capture(); });
+
+	BENCH_CHECK(state.mButtons[1] == ((FRAMES - 1 + 1) & 1));
+	BENCH_CHECK(std::abs(state.mAxes[2].abs - ((FRAMES - 1) * 1000 + 2)) <= 1);
+
+	im->destroyInputObject(joy);
+	InputManager::destroyInputSystem(im);
+}
+#endif
+
+//---------------------------------------------------------------------------------//
+static void benchDecodeUTF8()
+{
+	//Mix of 1, 2, 3 and 4 byte sequences
+	const char text[][5] = { "a", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80" };
+	std::uint32_t utf32[4];
+	volatile unsigned int sink = 0;
+
+	runBenchmark("Keyboard::decodeUTF8 (1 char)", 1024, noSetup, [&]() {
+		for(int i = 0; i < 1024; ++i)
+		{
+			Keyboard::decodeUTF8(text[i & 3], (i & 3) + 1, utf32, 4);
+			sink = sink + utf32[0];
+		}
+	});
+
+	//A long input method commit, mostly ASCII
+	const char commit[] = "The quick brown fox jumps over the lazy dog \xE2\x80\x94 caf\xC3\xA9 \xF0\x9F\x98\x80";
+	std::vector<std::uint32_t> out(sizeof(commit));
+
+	runBenchmark("Keyboard::decodeUTF8 (commit, per byte)", sizeof(commit) - 1, noSetup, [&]() {
+		sink = sink + (unsigned int)Keyboard::decodeUTF8(commit, sizeof(commit) - 1, &out[0], out.size());
+	});
+}
+
+//---------------------------------------------------------------------------------//
+static void benchKeyDispatch(InputManager* im)
+{
+	VirtualKeyboard* keyboard = static_cast<VirtualKeyboard*>(im->createInputObject(OISKeyboard, true, "Virtual"));
+	NullKeyListener listener;
+	keyboard->setEventCallback(&listener);
+
+	runBenchmark(
+		"Keyboard dispatch (virtual)", 256,
+		[&]() {
+			for(int i = 0; i < 128; ++i)
+			{
+				keyboard->injectKeyDown((OIS::KeyCode)(KC_A + (i & 15)), 'a' + (i & 15));
+				keyboard->injectKeyUp((OIS::KeyCode)(KC_A + (i & 15)));
+			}
+		},
+		[&]() { keyboard->capture(); });
+
+	im->destroyInputObject(keyboard);
+}
+
+//---------------------------------------------------------------------------------//
+static void benchMouseMotionHistory(InputManager* im)
+{
+	//A 8kHz mouse brings ~130 reports into a 60Hz frame
+	const int REPORTS = 128;
+	VirtualMouse* mouse = static_cast<VirtualMouse*>(im->createInputObject(OISMouse, true, "Virtual"));
+	NullMouseListener listener;
+	mouse->setEventCallback(&listener);
+
+	auto inject = [&]() {
+		for(int i = 0; i < REPORTS; ++i)
+			mouse->injectMove(1 + (i & 3), -(i & 1), 0, 1000 + i);
+	};
+
+	runBenchmark("Mouse capture (virtual, no history)", REPORTS * 2, inject, [&]() { mouse->capture(); });
+
+	mouse->setMotionHistorySize(REPORTS * 2);
+	runBenchmark("Mouse capture (virtual, motion history)", REPORTS * 2, inject, [&]() { mouse->capture(); });
+
+	//The samples add up to the summed state, also once the history overflows
+	mouse->setMotionHistorySize(16);
+	inject();
+	mouse->capture();
+
+	const MouseMotion *begin, *end;
+	mouse->getMotionHistory(begin, end);
+	int dx = 0, dy = 0;
+	for(const MouseMotion* m = begin; m != end; ++m)
+	{
+		dx += m->dx;
+		dy += m->dy;
+	}
+
+	BENCH_CHECK(end - begin == 16);
+	BENCH_CHECK(dx == mouse->getMouseState().X.rel && dy == mouse->getMouseState().Y.rel);
+	BENCH_CHECK((end - 1)->timestamp == 1000 + REPORTS - 1);
+
+	im->destroyInputObject(mouse);
+}
+
+//---------------------------------------------------------------------------------//
+static void benchKeyChords(InputManager* im)
+{
+	VirtualKeyboard* keyboard = static_cast<VirtualKeyboard*>(im->createInputObject(OISKeyboard, false, "Virtual"));
+	keyboard->injectKeyDown(KC_LCONTROL);
+	keyboard->injectKeyDown(KC_LSHIFT);
+	keyboard->injectKeyDown(KC_S);
+	keyboard->capture();
+
+	//A typical hotkey table: Ctrl+<key> and Ctrl+Shift+<key> for 16 keys
+	static const OIS::KeyCode hotkeys[16] = { KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_N, KC_O, KC_P, KC_Q, KC_R, KC_S, KC_V, KC_X, KC_Z };
+	std::vector<KeyChord> chords;
+	for(int i = 0; i < 16; ++i)
+	{
+		chords.push_back(KeyChord(KC_LCONTROL, hotkeys[i]).forbidOtherModifiers());
+		chords.push_back(KeyChord(KC_LCONTROL, KC_LSHIFT, hotkeys[i]).forbidOtherModifiers());
+	}
+
+	volatile int sink = 0;
+	runBenchmark("KeyChord matching (32 chords)", (unsigned)chords.size(), noSetup, [&]() {
+		const KeyMask& keys = keyboard->getKeyStates();
+		int matched			= 0;
+		for(std::size_t i = 0; i < chords.size(); ++i)
+			matched += chords[i].matches(keys);
+		sink = matched;
+	});
+
+	BENCH_CHECK(sink == 1);
+	BENCH_CHECK(keyboard->isChordDown(KeyChord(KC_LCONTROL, KC_LSHIFT, KC_S).forbidOtherModifiers()));
+	BENCH_CHECK(!keyboard->isChordDown(KeyChord(KC_LCONTROL, KC_S).forbidOtherModifiers()));
+
+	im->destroyInputObject(keyboard);
+}
+
+//---------------------------------------------------------------------------------//
+static void benchJoyStickStateClear()
+{
+	JoyStickState state;
+	state.mButtons.resize(32);
+	state.mAxes.resize(8);
+
+	runBenchmark("JoyStickState::clear", 64, noSetup, [&]() {
+		for(int i = 0; i < 64; ++i)
+			state.clear();
+	});
+}
+
+//---------------------------------------------------------------------------------//
+static void benchCreateInputObject(InputManager* im)
+{
+	runBenchmark("createInputObject (virtual joystick)", 1, noSetup, [&]() {
+		im->destroyInputObject(im->createInputObject(OISJoyStick, true, "Virtual"));
+	});
+}
+
+//---------------------------------------------------------------------------------//
+int main(int argc, char** argv)
+{
+	if(argc > 1)
+		g_Filter = argv[1];
+
+	try
+	{
+		ParamList pl;
+		InputManager* im = InputManager::createInputSystem(pl);
+
+		VirtualFactoryCreator virtualDevices;
+		im->addFactoryCreator(&virtualDevices);
+
+#if defined OIS_LINUX_PLATFORM
+		benchJoyStickCapture(im);
+		benchKeySymLookup(im);
+		benchUInputJoyStick();
+#endif
+		benchDecodeUTF8();
+		benchKeyDispatch(im);
+		benchMouseMotionHistory(im);
+		benchKeyChords(im);
+		benchJoyStickStateClear();
+		benchCreateInputObject(im);
+
+		im->removeFactoryCreator(&virtualDevices);
+		InputManager::destroyInputSystem(im);
+	}
+	catch(const Exception& ex)
+	{
+		std::printf("\nOIS Exception Caught!\n\t%s (Line: %d in %s)\n", ex.eText, ex.eLine, ex.eFile);
+		return 1;
+	}
+
+	return g_Failures ? 1 : 0;
+}
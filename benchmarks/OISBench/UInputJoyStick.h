@@ -0,0 +1,158 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef OIS_UInputJoyStick_H
+#define OIS_UInputJoyStick_H
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+/**
+	Synthetic gamepad created through /dev/uinput, for exercising the evdev joystick path
+	without hardware. Buttons are BTN_GAMEPAD.. followed by BTN_TRIGGER_HAPPY.., axes are
+	ABS_X..ABS_BRAKE and hats ABS_HAT0X/Y.., so OIS numbers them in the same order.
+	Needs write access to /dev/uinput; check valid() after construction.
+*/
+class UInputJoyStick
+{
+public:
+	static const int MAX_AXES = ABS_BRAKE + 1;
+	static const int MAX_HATS = 4;
+
+	UInputJoyStick(const std::string& name, int buttons, int axes, int hats, bool forceFeedback, int axisMin = -32768, int axisMax = 32767) :
+	 mFd(-1), mButtons(buttons), mAxes(std::min(axes, (int)MAX_AXES)), mHats(std::min(hats, (int)MAX_HATS))
+	{
+		mFd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+		if(mFd == -1)
+			return;
+
+		uinput_user_dev dev;
+		memset(&dev, 0, sizeof(dev));
+		strncpy(dev.name, name.c_str(), UINPUT_MAX_NAME_SIZE - 1);
+		dev.id.bustype = BUS_VIRTUAL;
+		dev.id.vendor  = 0x4f49; //"OI"
+		dev.id.product = 0x5342; //"SB"
+		dev.id.version = 1;
+
+		bool ok = ioctl(mFd, UI_SET_EVBIT, EV_KEY) == 0 && ioctl(mFd, UI_SET_EVBIT, EV_SYN) == 0;
+		for(int i = 0; i < mButtons; ++i)
+			ok = ok && ioctl(mFd, UI_SET_KEYBIT, buttonCode(i)) == 0;
+
+		if(mAxes > 0 || mHats > 0)
+			ok = ok && ioctl(mFd, UI_SET_EVBIT, EV_ABS) == 0;
+		for(int i = 0; i < mAxes; ++i)
+		{
+			ok				   = ok && ioctl(mFd, UI_SET_ABSBIT, ABS_X + i) == 0;
+			dev.absmin[ABS_X + i] = axisMin;
+			dev.absmax[ABS_X + i] = axisMax;
+		}
+		for(int i = 0; i < mHats * 2; ++i)
+		{
+			ok						   = ok && ioctl(mFd, UI_SET_ABSBIT, ABS_HAT0X + i) == 0;
+			dev.absmin[ABS_HAT0X + i] = -1;
+			dev.absmax[ABS_HAT0X + i] = 1;
+		}
+
+		if(forceFeedback)
+		{
+			ok				   = ok && ioctl(mFd, UI_SET_EVBIT, EV_FF) == 0;
+			ok				   = ok && ioctl(mFd, UI_SET_FFBIT, FF_RUMBLE) == 0;
+			ok				   = ok && ioctl(mFd, UI_SET_FFBIT, FF_CONSTANT) == 0;
+			dev.ff_effects_max = 16;
+		}
+
+		ok = ok && write(mFd, &dev, sizeof(dev)) == (ssize_t)sizeof(dev);
+		ok = ok && ioctl(mFd, UI_DEV_CREATE) == 0;
+		if(!ok)
+		{
+			close(mFd);
+			mFd = -1;
+			return;
+		}
+
+		//Give udev a moment to create the /dev/input/event node
+		usleep(200000);
+	}
+
+	~UInputJoyStick()
+	{
+		if(mFd != -1)
+		{
+			ioctl(mFd, UI_DEV_DESTROY);
+			close(mFd);
+		}
+	}
+
+	bool valid() const { return mFd != -1; }
+
+	static int buttonCode(int index)
+	{
+		const int GAMEPAD_BUTTONS = BTN_THUMBR - BTN_GAMEPAD + 1;
+		return index < GAMEPAD_BUTTONS ? BTN_GAMEPAD + index : BTN_TRIGGER_HAPPY1 + index - GAMEPAD_BUTTONS;
+	}
+
+	void button(int index, bool pressed) { emit(EV_KEY, buttonCode(index), pressed ? 1 : 0); }
+
+	void axis(int index, int value) { emit(EV_ABS, ABS_X + index, value); }
+
+	//! x and y are -1, 0 or 1 (left/up, centered, right/down)
+	void hat(int index, int x, int y)
+	{
+		emit(EV_ABS, ABS_HAT0X + index * 2, x);
+		emit(EV_ABS, ABS_HAT0Y + index * 2, y);
+	}
+
+	//! Ends the frame, nothing reaches readers before this
+	void sync() { emit(EV_SYN, SYN_REPORT, 0); }
+
+	//! Queues a raw event
+	void emit(int type, int code, int value)
+	{
+		input_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.type	 = type;
+		ev.code	 = code;
+		ev.value = value;
+		emit(&ev, 1);
+	}
+
+	//! Queues many raw events with one syscall
+	void emit(const input_event* events, int count)
+	{
+		if(write(mFd, events, sizeof(input_event) * count) != (ssize_t)(sizeof(input_event) * count)) { }
+	}
+
+protected:
+	int mFd;
+	int mButtons, mAxes, mHats;
+};
+
+#endif //OIS_UInputJoyStick_H
@@ -226,35 +226,30 @@ int main()
 				DispatchMessage(&msg);
 			}
 #elif defined OIS_LINUX_PLATFORM
-			   checkX11Events();
-			   usleep(500);
+			checkX11Events();
+			//Sleep in the kernel until a device has input (or we need to look at our window again),
+			//this captures every device so they must not be captured again below
+			g_InputManager->waitForInput(100);
 #elif defined OIS_APPLE_PLATFORM
 			checkMacEvents();
 			usleep(500);
 #endif
 
-			if(g_kb)
-			{
-				g_kb->capture();
-				if(!g_kb->buffered())
-					handleNonBufferedKeys();
-			}
+#if !defined OIS_LINUX_PLATFORM
+			//No kernel wait there (waitForInput would only sleep), the platform's own sleep above throttles us
+			g_InputManager->captureAll();
+#endif
 
-			if(g_m)
-			{
-				g_m->capture();
-				if(!g_m->buffered())
-					handleNonBufferedMouse();
-			}
+			if(g_kb && !g_kb->buffered())
+				handleNonBufferedKeys();
+
+			if(g_m && !g_m->buffered())
+				handleNonBufferedMouse();
 
 			for(int i = 0; i < 4; ++i)
 			{
-				if(g_joys[i])
-				{
-					g_joys[i]->capture();
-					if(!g_joys[i]->buffered())
-						handleNonBufferedJoy(g_joys[i]);
-				}
+				if(g_joys[i] && !g_joys[i]->buffered())
+					handleNonBufferedJoy(g_joys[i]);
 			}
 		}
 	}
@@ -0,0 +1,347 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef OIS_BitSet_H
+#define OIS_BitSet_H
+
+#include "OISPrereqs.h"
+#include <algorithm>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace OIS
+{
+	//! Index of the lowest set bit of a non zero word
+	inline unsigned int _countTrailingZeros(std::uint64_t word)
+	{
+#if defined(_MSC_VER) && defined(_WIN64)
+		unsigned long index;
+		_BitScanForward64(&index, word);
+		return index;
+#elif defined(_MSC_VER)
+		unsigned long index;
+		if(_BitScanForward(&index, (unsigned long)word))
+			return index;
+		_BitScanForward(&index, (unsigned long)(word >> 32));
+		return index + 32;
+#else
+		return (unsigned int)__builtin_ctzll(word);
+#endif
+	}
+
+	//! Number of set bits of a word
+	inline unsigned int _popCount(std::uint64_t word)
+	{
+#if defined(_MSC_VER)
+		return (unsigned int)(__popcnt((unsigned int)word) + __popcnt((unsigned int)(word >> 32)));
+#else
+		return (unsigned int)__builtin_popcountll(word);
+#endif
+	}
+
+	//! Index of the first set bit at or after pos in an array of words, numBits if there is none
+	inline std::size_t _findNextBit(const std::uint64_t* words, std::size_t numWords, std::size_t numBits, std::size_t pos)
+	{
+		std::size_t w = pos >> 6;
+		if(w >= numWords)
+			return numBits;
+
+		std::uint64_t word = words[w] & (~std::uint64_t(0) << (pos & 63));
+		while(word == 0)
+		{
+			if(++w == numWords)
+				return numBits;
+			word = words[w];
+		}
+
+		return (w << 6) + _countTrailingZeros(word);
+	}
+
+	/**
+		Range over the indices of the set bits of a BitSet or FixedBitSet, for use in range
+		based for loops: for(std::size_t i : bits.setBits())
+	*/
+	template <typename T>
+	class SetBits
+	{
+	public:
+		class iterator
+		{
+		public:
+			iterator(const T* bits, std::size_t pos) :
+			 mBits(bits), mPos(pos) { }
+
+			std::size_t operator*() const { return mPos; }
+			iterator& operator++()
+			{
+				mPos = mBits->findNext(mPos + 1);
+				return *this;
+			}
+			bool operator==(const iterator& other) const { return mPos == other.mPos; }
+			bool operator!=(const iterator& other) const { return mPos != other.mPos; }
+
+		private:
+			const T* mBits;
+			std::size_t mPos;
+		};
+
+		explicit SetBits(const T& bits) :
+		 mBits(bits) { }
+
+		iterator begin() const { return iterator(&mBits, mBits.findFirst()); }
+		iterator end() const { return iterator(&mBits, mBits.size()); }
+
+	private:
+		const T& mBits;
+	};
+
+	//! Assignable reference to one bit, returned by the non const operator[] of the bit sets
+	class BitReference
+	{
+	public:
+		BitReference(std::uint64_t& word, std::uint64_t mask) :
+		 mWord(word), mMask(mask) { }
+
+		operator bool() const { return (mWord & mMask) != 0; }
+		BitReference& operator=(bool value)
+		{
+			mWord = value ? (mWord | mMask) : (mWord & ~mMask);
+			return *this;
+		}
+		BitReference& operator=(const BitReference& other) { return *this = (bool)other; }
+
+	private:
+		std::uint64_t& mWord;
+		std::uint64_t mMask;
+	};
+
+	/**
+		Dynamically sized set of bits stored in contiguous 64 bit words. Indexing works like
+		std::vector<bool> (including assignment through operator[]), while test/set avoid the
+		proxy and findNext/setBits scan for set bits a whole word at a time.
+	*/
+	class BitSet
+	{
+	public:
+		typedef BitReference reference;
+
+		BitSet() :
+		 mSize(0) { }
+
+		explicit BitSet(std::size_t size, bool value = false) :
+		 mSize(0) { resize(size, value); }
+
+		//! Number of bits
+		std::size_t size() const { return mSize; }
+		bool empty() const { return mSize == 0; }
+
+		//! Changes the number of bits, new bits get value
+		void resize(std::size_t size, bool value = false)
+		{
+			std::size_t oldSize = mSize;
+			mWords.resize((size + 63) >> 6, 0);
+			mSize = size;
+			_trim();
+			for(std::size_t i = oldSize; i < size && value; ++i)
+				set(i);
+		}
+
+		//! Removes all bits (like std::vector::clear, use reset to clear the values)
+		void clear()
+		{
+			mWords.clear();
+			mSize = 0;
+		}
+
+		bool operator[](std::size_t i) const { return test(i); }
+		reference operator[](std::size_t i) { return reference(mWords[i >> 6], std::uint64_t(1) << (i & 63)); }
+
+		bool test(std::size_t i) const { return (mWords[i >> 6] >> (i & 63)) & 1; }
+
+		void set(std::size_t i, bool value = true)
+		{
+			std::uint64_t mask = std::uint64_t(1) << (i & 63);
+			mWords[i >> 6]	   = value ? (mWords[i >> 6] | mask) : (mWords[i >> 6] & ~mask);
+		}
+
+		//! Sets every bit to false
+		void reset() { std::fill(mWords.begin(), mWords.end(), 0); }
+
+		//! Returns true if any bit is set
+		bool any() const
+		{
+			for(std::size_t w = 0; w < mWords.size(); ++w)
+				if(mWords[w])
+					return true;
+			return false;
+		}
+
+		//! Number of set bits
+		std::size_t count() const
+		{
+			std::size_t n = 0;
+			for(std::size_t w = 0; w < mWords.size(); ++w)
+				n += _popCount(mWords[w]);
+			return n;
+		}
+
+		//! Index of the first set bit at or after pos, size() if there is none
+		std::size_t findNext(std::size_t pos) const { return _findNextBit(data(), mWords.size(), mSize, pos); }
+
+		//! Index of the first set bit, size() if there is none
+		std::size_t findFirst() const { return findNext(0); }
+
+		//! Indices of the set bits, in increasing order
+		SetBits<BitSet> setBits() const { return SetBits<BitSet>(*this); }
+
+		//! The words holding the bits, bit i is bit (i % 64) of word (i / 64). Unused high bits are 0
+		const std::uint64_t* data() const { return mWords.empty() ? 0 : &mWords[0]; }
+		std::size_t numWords() const { return mWords.size(); }
+
+		bool operator==(const BitSet& other) const { return mSize == other.mSize && mWords == other.mWords; }
+		bool operator!=(const BitSet& other) const { return !(*this == other); }
+
+	protected:
+		//! Clears the bits past mSize in the last word, so whole words can be compared and scanned
+		void _trim()
+		{
+			if(mSize & 63)
+				mWords.back() &= (std::uint64_t(1) << (mSize & 63)) - 1;
+		}
+
+		std::vector<std::uint64_t> mWords;
+		std::size_t mSize;
+	};
+
+	/**
+		Set of a fixed number of bits (a multiple of 64) stored inline, with the same
+		interface as BitSet plus the bitwise operators. Used where the size is known up
+		front, like the 256 keys of a keyboard.
+	*/
+	template <std::size_t Bits>
+	class FixedBitSet
+	{
+	public:
+		typedef BitReference reference;
+
+		//! Number of 64 bit words
+		static const std::size_t Words = (Bits + 63) / 64;
+
+		FixedBitSet() { reset(); }
+
+		std::size_t size() const { return Bits; }
+
+		bool operator[](std::size_t i) const { return test(i); }
+		reference operator[](std::size_t i) { return reference(mWords[i >> 6], std::uint64_t(1) << (i & 63)); }
+
+		bool test(std::size_t i) const { return (mWords[i >> 6] >> (i & 63)) & 1; }
+
+		void set(std::size_t i, bool value = true)
+		{
+			std::uint64_t mask = std::uint64_t(1) << (i & 63);
+			mWords[i >> 6]	   = value ? (mWords[i >> 6] | mask) : (mWords[i >> 6] & ~mask);
+		}
+
+		//! Sets every bit to false
+		void reset()
+		{
+			for(std::size_t w = 0; w < Words; ++w)
+				mWords[w] = 0;
+		}
+
+		//! Returns true if any bit is set
+		bool any() const
+		{
+			std::uint64_t bits = 0;
+			for(std::size_t w = 0; w < Words; ++w)
+				bits |= mWords[w];
+			return bits != 0;
+		}
+
+		//! Number of set bits
+		std::size_t count() const
+		{
+			std::size_t n = 0;
+			for(std::size_t w = 0; w < Words; ++w)
+				n += _popCount(mWords[w]);
+			return n;
+		}
+
+		//! Index of the first set bit at or after pos, size() if there is none
+		std::size_t findNext(std::size_t pos) const { return _findNextBit(mWords, Words, Bits, pos); }
+
+		//! Index of the first set bit, size() if there is none
+		std::size_t findFirst() const { return findNext(0); }
+
+		//! Indices of the set bits, in increasing order
+		SetBits<FixedBitSet> setBits() const { return SetBits<FixedBitSet>(*this); }
+
+		//! The words holding the bits, bit i is bit (i % 64) of word (i / 64)
+		const std::uint64_t* data() const { return mWords; }
+		std::uint64_t* data() { return mWords; }
+		std::size_t numWords() const { return Words; }
+
+		bool operator==(const FixedBitSet& other) const
+		{
+			std::uint64_t diff = 0;
+			for(std::size_t w = 0; w < Words; ++w)
+				diff |= mWords[w] ^ other.mWords[w];
+			return diff == 0;
+		}
+		bool operator!=(const FixedBitSet& other) const { return !(*this == other); }
+
+		FixedBitSet& operator|=(const FixedBitSet& other)
+		{
+			for(std::size_t w = 0; w < Words; ++w)
+				mWords[w] |= other.mWords[w];
+			return *this;
+		}
+
+		FixedBitSet& operator&=(const FixedBitSet& other)
+		{
+			for(std::size_t w = 0; w < Words; ++w)
+				mWords[w] &= other.mWords[w];
+			return *this;
+		}
+
+		FixedBitSet operator|(const FixedBitSet& other) const { return FixedBitSet(*this) |= other; }
+		FixedBitSet operator&(const FixedBitSet& other) const { return FixedBitSet(*this) &= other; }
+
+		FixedBitSet operator~() const
+		{
+			FixedBitSet result;
+			for(std::size_t w = 0; w < Words; ++w)
+				result.mWords[w] = ~mWords[w];
+			return result;
+		}
+
+	protected:
+		std::uint64_t mWords[Words];
+	};
+}
+#endif
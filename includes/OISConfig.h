@@ -75,4 +75,13 @@ following restrictions:
 */
 //#define OIS_WIN32_XINPUT_SUPPORT
 
+/**
+@remarks
+	Build in support for XInput2 raw mouse motion on Linux (requires libXi). Without it,
+	or when the X server lacks XInput 2, a grabbed mouse warps the pointer back to the
+	window centre instead. With XInput 2.1 a grabbed mouse also scrolls smoothly, rather
+	than in whole wheel notches
+*/
+//#define OIS_LINUX_XI2_SUPPORT
+
 #endif
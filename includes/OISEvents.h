@@ -35,12 +35,92 @@ namespace OIS
 	class _OISExport EventArg
 	{
 	public:
-		explicit EventArg(Object* obj) :
-		 device(obj) { }
+		explicit EventArg(Object* obj, std::uint64_t time = 0) :
+		 device(obj), timestamp(time) { }
 		virtual ~EventArg() { }
 
 		//! Pointer to the Input Device
 		const Object* device;
+
+		/**
+			Time the event happened in nanoseconds of a monotonic clock (CLOCK_MONOTONIC
+			on Linux), as reported by the kernel or window system. 0 when unknown.
+		*/
+		std::uint64_t timestamp;
+	};
+
+	/**
+		Compact, trivially copyable record of a single input change. Devices collect these
+		into a reusable array during capture() and hand them to a BatchListener in one call.
+		The meaning of code and value depends on type.
+	*/
+	struct InputEvent
+	{
+		enum EventType {
+			KeyPressed,		//!< code is the KeyCode, value the translated text
+			KeyReleased,	//!< code is the KeyCode
+			MouseMoved,		//!< code is the axis (0 X, 1 Y, 2 Z, 3 H), value the relative motion
+			MousePressed,	//!< code is the MouseButtonID
+			MouseReleased,	//!< code is the MouseButtonID
+			ButtonPressed,	//!< code is the joystick button
+			ButtonReleased, //!< code is the joystick button
+			AxisMoved,		//!< code is the joystick axis, value the absolute position
+			PovMoved,		//!< code is the POV index, value the Pov direction bits
+			TextEntered		//!< value is one UTF-32 code point of committed text
+		};
+
+		//! Same clock as EventArg::timestamp
+		std::uint64_t timestamp;
+		std::int32_t value;
+		std::uint16_t code;
+		std::uint16_t type;
+	};
+
+	/**
+		InputEvent tagged with the device which produced it. All devices of an InputManager
+		append these to its event log (see InputManager::enableEventLog), giving one flat,
+		allocation free stream of everything that happened across devices.
+	*/
+	struct RawEvent
+	{
+		//! Same clock as EventArg::timestamp
+		std::uint64_t timestamp;
+		//! As in InputEvent
+		std::int32_t value;
+		std::uint16_t code;
+		std::uint16_t type;
+		//! Object::getID of the device
+		std::uint16_t device;
+		//! Object::type of the device
+		std::uint16_t deviceType;
+	};
+
+	/**
+		To recieve all of a device's buffered events in one call per capture() instead of one
+		virtual call per change, derive from this and set it with Object::setBatchCallback.
+		Batches are delivered in addition to the device's regular listener, if any.
+
+		Batches (and the InputManager event log) are filled by the Linux, Win32, Carbon Mac
+		and virtual devices, and by Cocoa joysticks. The Cocoa keyboard and mouse dispatch
+		from their NSResponder and do not record InputEvents yet. Polled sources (Win32
+		mouse and XInput, Mac) have no per event clock and record a timestamp of 0.
+	*/
+	class _OISExport BatchListener
+	{
+	public:
+		virtual ~BatchListener() { }
+
+		/**
+		@remarks
+			Called once at the end of capture() when the device produced any events
+		@param device
+			The device that captured the events
+		@param begin
+			First event, in the order they happened
+		@param end
+			One past the last event. The array is reused, so copy out what you need to keep
+		*/
+		virtual void onEvents(const Object* device, const InputEvent* begin, const InputEvent* end) = 0;
 	};
 }
 
@@ -28,12 +28,18 @@ following restrictions:
 #define OIS_InputManager_H
 
 #include "OISPrereqs.h"
+#include <atomic>
 
 namespace OIS
 {
 	//Forward declare a couple of classes we might use later
 	class LIRCFactoryCreator;
 	class WiiMoteFactoryCreator;
+	struct InputEvent;
+	struct RawEvent;
+	class EventRecorder;
+	template <typename T>
+	class RingBuffer;
 
 	/**
 		Base Manager class. No longer a Singleton; so feel free to create as many InputManager's as you have
@@ -120,6 +126,79 @@ namespace OIS
 		*/
 		void destroyInputObject(Object* obj);
 
+		/**
+		@remarks
+			Captures every device created through this manager in a single call. Platforms
+			which can multiplex their devices (Linux uses one epoll set) only read the devices
+			that actually have pending input, the idle ones just have their relative axes and
+			pressed/released masks cleared as a capture would. Otherwise this is equivalent to
+			calling Object::capture on every created device.
+		*/
+		virtual void captureAll();
+
+		/**
+		@remarks
+			Sleeps until any device has input or the timeout expires, then captures the
+			devices as captureAll does, dispatching to the usual listeners. Useful for tools
+			which only need to react to input and should not spin a core polling for it.
+			Platforms without a kernel wait primitive (everything but Linux) cannot tell when
+			input arrives, they sleep for the whole timeout (PollInterval for -1) and then
+			capture all devices.
+		@param timeoutMs
+			Milliseconds to wait, 0 returns immediately and -1 waits forever
+		@returns
+			True if any device had input, false on timeout. Always true on platforms which
+			cannot tell
+		*/
+		virtual bool waitForInput(int timeoutMs);
+
+		//! Milliseconds waitForInput(-1) sleeps between captures on platforms without a wait primitive
+		static const int PollInterval = 10;
+
+		/**
+		@remarks
+			Starts logging every event of every device created by this manager into a
+			preallocated ring buffer of RawEvent records. Any events still in a previous
+			log are discarded.
+		@param numEvents
+			Capacity of the log (rounded up to a power of two), 0 disables logging
+		@notes
+			When the log is full new events are dropped and counted, see getEventLogOverruns.
+			Devices which do not record InputEvents (see BatchListener) add nothing to the log
+		*/
+		void enableEventLog(unsigned int numEvents);
+
+		/**
+		@remarks
+			Moves the oldest logged events into the supplied array. May be called from a
+			different thread than the one capturing the devices (but only from one thread)
+		@returns
+			Number of events copied, 0 when the log is empty or disabled
+		*/
+		unsigned int readEventLog(RawEvent* events, unsigned int maxEvents);
+
+		/** @remarks Number of events dropped because the event log was full, may be polled from any thread */
+		unsigned int getEventLogOverruns() const { return mEventLogOverruns.load(std::memory_order_relaxed); }
+
+		/**
+		@remarks
+			Records every event of every device created by this manager to a file, which
+			ReplayFactoryCreator can play back later. Replaces a recording in progress.
+			Raises an exception if the file cannot be created or on unsupported platforms
+		@param fileName
+			File to create (or overwrite)
+		*/
+		void startRecording(const std::string& fileName);
+
+		/** @remarks Finishes and closes the current recording, if any */
+		void stopRecording();
+
+		/** @remarks Internal... Returns true if devices should send their events to _logEvent */
+		bool _isLogging() const { return mEventLog != nullptr || mRecorder != nullptr; }
+
+		/** @remarks Internal... Appends a device event to the event log */
+		void _logEvent(const Object* device, const InputEvent& evt);
+
 		/**
 		@remarks
 			Add a custom object factory to allow for user controls.
@@ -204,6 +283,14 @@ namespace OIS
 		LIRCFactoryCreator* m_lircSupport;
 		WiiMoteFactoryCreator* m_wiiMoteSupport;
 
+		//! Log of all device events (0 when disabled)
+		RingBuffer<RawEvent>* mEventLog;
+		//! Dropped events, polled from other threads. Relaxed, nothing is ordered against it
+		std::atomic<unsigned int> mEventLogOverruns;
+
+		//! Recording in progress (0 when not recording)
+		EventRecorder* mRecorder;
+
 	private:
 		// Prevent copying.
 		InputManager(const InputManager&);
@@ -27,12 +27,20 @@ following restrictions:
 #define OIS_Joystick_H
 #include "OISObject.h"
 #include "OISEvents.h"
+#include "OISBitSet.h"
+#include <algorithm>
 
 namespace OIS
 {
 /** @remarks default sensitivity for vector3 component of joystick */
 #define OIS_JOYSTICK_VECTOR3_DEFAULT 2.28f
 
+/** @remarks default sensitivity (in axis units) for axis events of joystick */
+#define OIS_JOYSTICK_AXIS_DEFAULT 0
+
+/** @remarks number of segments of an axis response curve lookup table (covers 0 to 32768 in steps of 128) */
+#define OIS_JOYSTICK_CURVE_SEGMENTS 256
+
 	//! POV / HAT Joystick component
 	class _OISExport Pov : public Component
 	{
@@ -72,19 +80,20 @@ namespace OIS
 	{
 	public:
 		//! Constructor
-		JoyStickState() { clear(); }
+		JoyStickState() :
+		 mPOV(4), mSliders(4) { clear(); }
 
 		//! Represents all the buttons (uses a bitset)
-		std::vector<bool> mButtons;
+		BitSet mButtons;
 
 		//! Represents all the single axes on the device
 		std::vector<Axis> mAxes;
 
-		//! Represents the value of a POV. Maximum of 4
-		Pov mPOV[4];
+		//! Represents the value of each POV. Holds at least 4, backends grow it for devices with more
+		std::vector<Pov> mPOV;
 
-		//! Represent the max sliders
-		Slider mSliders[4];
+		//! Represents the value of each slider. Holds at least 4, backends grow it for devices with more
+		std::vector<Slider> mSliders;
 
 		//! Represents all Vector type controls the device exports
 		std::vector<Vector3> mVectors;
@@ -92,10 +101,7 @@ namespace OIS
 		//! internal method to reset all variables to initial values
 		void clear()
 		{
-			for(std::vector<bool>::iterator i = mButtons.begin(), e = mButtons.end(); i != e; ++i)
-			{
-				(*i) = false;
-			}
+			mButtons.reset();
 
 			for(std::vector<Axis>::iterator i = mAxes.begin(), e = mAxes.end(); i != e; ++i)
 			{
@@ -108,10 +114,14 @@ namespace OIS
 				i->clear();
 			}
 
-			for(int i = 0; i < 4; ++i)
+			for(std::vector<Pov>::iterator i = mPOV.begin(), e = mPOV.end(); i != e; ++i)
+			{
+				i->direction = Pov::Centered;
+			}
+
+			for(std::vector<Slider>::iterator i = mSliders.begin(), e = mSliders.end(); i != e; ++i)
 			{
-				mPOV[i].direction = Pov::Centered;
-				mSliders[i].abX = mSliders[i].abY = 0;
+				i->abX = i->abY = 0;
 			}
 		}
 	};
@@ -120,8 +130,8 @@ namespace OIS
 	class _OISExport JoyStickEvent : public EventArg
 	{
 	public:
-		JoyStickEvent(Object* obj, const JoyStickState& st) :
-		 EventArg(obj), state(st) { }
+		JoyStickEvent(Object* obj, const JoyStickState& st, std::uint64_t time = 0) :
+		 EventArg(obj, time), state(st) { }
 		virtual ~JoyStickEvent() { }
 
 		const JoyStickState& state;
@@ -211,6 +221,23 @@ namespace OIS
 		*/
 		float getVector3Sensitivity() const;
 
+		/**
+		@remarks
+			Sets a cutoff limit for changes of an axis to be ignored. An axis only generates
+			events once it moved further than this from the value last delivered, which
+			keeps noisy analog sticks quiet. Reaching the center or either end is always
+			delivered, and an unchanged value never is. The state always holds the latest value.
+		@param units
+			Change (in axis units) under which axis events are discarded, 0 only discards repeats
+		*/
+		void setAxisSensitivity(int units = OIS_JOYSTICK_AXIS_DEFAULT);
+
+		/**
+		@remarks
+			Returns the sensitivity cutoff for axes
+		*/
+		int getAxisSensitivity() const;
+
 		/**
 		@remarks
 			Register/unregister a JoyStick Listener - Only one allowed for simplicity. If broadcasting
@@ -226,15 +253,219 @@ namespace OIS
 		/** @remarks Returns the state of the joystick - is valid for both buffered and non buffered mode */
 		const JoyStickState& getJoyStickState() const { return mState; }
 
+		/**
+		@remarks
+			Returns how many times input was lost because the device was not captured fast enough
+			(Linux: SYN_DROPPED). Each time, the state was read back from the device and the
+			differences were delivered as regular events. Always 0 where this cannot be detected
+		*/
+		unsigned int getDroppedFrames() const { return mDroppedFrames; }
+
+		/**
+		@remarks
+			Returns true if the button went down during the last capture (it may have been
+			released again since). Works in both buffered and non buffered mode
+		*/
+		bool wasPressed(int button) const { return (std::size_t)button < mPressedButtons.size() && mPressedButtons.test(button); }
+
+		/** @remarks Returns true if the button went up during the last capture */
+		bool wasReleased(int button) const { return (std::size_t)button < mReleasedButtons.size() && mReleasedButtons.test(button); }
+
+		/** @remarks Returns true if the axis was reported as moved during the last capture (see setAxisSensitivity) */
+		bool wasAxisMoved(int axis) const { return (std::size_t)axis < mMovedAxes.size() && mMovedAxes.test(axis); }
+
+		/**
+		@remarks
+			Buttons that went down during the last capture. Iterate over them with
+			getPressedButtons().setBits() instead of checking every button
+		*/
+		const BitSet& getPressedButtons() const { return mPressedButtons; }
+
+		/** @remarks Buttons that went up during the last capture */
+		const BitSet& getReleasedButtons() const { return mReleasedButtons; }
+
+		/** @remarks Axes reported as moved during the last capture */
+		const BitSet& getMovedAxes() const { return mMovedAxes; }
+
 		//! The minimal axis value
 		static const int MIN_AXIS = -32768;
 
 		//! The maximum axis value
 		static const int MAX_AXIS = 32767;
 
+		/**
+		@remarks
+			Sets the dead zone of an axis. Values closer to the center than the dead zone read 0,
+			the rest is rescaled so the axis still reaches MIN_AXIS/MAX_AXIS. Axes start without
+			a dead zone, on Linux the linux_joystick_flat param starts them with input_absinfo::flat
+		@param axis
+			Axis index
+		@param deadZone
+			Dead zone in axis units, 0 to MAX_AXIS
+		*/
+		void setAxisDeadZone(int axis, int deadZone);
+
+		/** @remarks Returns the dead zone of an axis */
+		int getAxisDeadZone(int axis) const;
+
+		/**
+		@remarks
+			Sets a radial dead zone on a pair of axes (ie. the X/Y of a stick), which keeps
+			diagonals as responsive as the main directions. Applied before each axis' own dead
+			zone and response curve.
+		@param deadZone
+			Dead zone in axis units, 0 removes the pairing
+		*/
+		void setAxisRadialDeadZone(int axisX, int axisY, int deadZone);
+
+		/**
+		@remarks
+			Sets the response curve of an axis, applied symmetrically to both directions.
+		@param axis
+			Axis index
+		@param points
+			Output values (0 to MAX_AXIS) for evenly spaced inputs from 0 to MAX_AXIS, first point
+			is for input 0 and last for MAX_AXIS. Needs at least 2 points, an empty list makes
+			the axis linear again
+		*/
+		void setAxisResponseCurve(int axis, const std::vector<int>& points);
+
+		/**
+		@remarks
+			Convenience for setAxisResponseCurve: output = input ^ exponent (on the 0 - 1 range).
+			Exponents above 1 give finer control around the center, 1 is linear
+		*/
+		void setAxisResponseExponent(int axis, float exponent);
+
+		/** @copydoc Object::_clearFrame */
+		virtual void _clearFrame() { _beginFrame(); }
+
 	protected:
 		JoyStick(const std::string& vendor, bool buffered, int devID, InputManager* creator);
 
+		//! Calibration of an axis, see setAxisDeadZone and friends
+		struct AxisCalibration
+		{
+			AxisCalibration() :
+			 deadZone(0), deadZoneScale(1 << 16), radialPartner(-1), radialDeadZone(0), raw(0) { }
+
+			std::int32_t deadZone;
+			//! Q16 factor stretching the range left after the dead zone back to full range
+			std::int64_t deadZoneScale;
+			int radialPartner;
+			std::int32_t radialDeadZone;
+			//! Last value before calibration, needed by the radial partner
+			std::int32_t raw;
+			//! OIS_JOYSTICK_CURVE_SEGMENTS + 2 Q15 outputs (32768 is full deflection), or empty for linear
+			std::vector<std::int32_t> curve;
+		};
+
+		//! Applies dead zone and response curve to a value, without branching on the value
+		static inline std::int32_t _calibrate(const AxisCalibration& cal, std::int32_t value)
+		{
+			std::int32_t sign = value >> 31; //0 or -1
+			std::int32_t mag  = (value ^ sign) - sign;
+
+			mag = std::max<std::int32_t>(mag - cal.deadZone, 0);
+			mag = std::min<std::int32_t>((std::int32_t)((mag * cal.deadZoneScale) >> 16), MAX_AXIS + 1);
+			if(!cal.curve.empty())
+			{
+				//Full deflection is MAX_AXIS one way and -MIN_AXIS the other, the curve is relative to that
+				std::int64_t range		= MAX_AXIS - sign;
+				std::int64_t step		= ((std::int64_t)OIS_JOYSTICK_CURVE_SEGMENTS << 24) / range + 1; //Q24 segments per unit, rounded up
+				std::int64_t pos		= mag * step;
+				const std::int32_t* lut = &cal.curve[(std::size_t)std::min<std::int64_t>(pos >> 24, OIS_JOYSTICK_CURVE_SEGMENTS)];
+				std::int32_t frac		= (std::int32_t)((pos >> 16) & 0xFF);
+				std::int64_t out		= lut[0] + (((lut[1] - lut[0]) * frac) >> 8);
+				mag						= (std::int32_t)((out * range + (1 << 14)) >> 15);
+			}
+
+			//Negative values may reach MIN_AXIS, positive only MAX_AXIS
+			mag = std::min<std::int32_t>(mag, MAX_AXIS - sign);
+			return (mag ^ sign) - sign;
+		}
+
+		/**
+		@remarks
+			Backends call this with the normalized (MIN_AXIS to MAX_AXIS) value of an axis, to
+			store the calibrated value in mState.
+		@returns
+			The radial partner axis, whose value changed too, or -1
+		*/
+		inline int _setAxis(int axis, std::int32_t value)
+		{
+			if((std::size_t)axis >= mCalibration.size())
+			{
+				mState.mAxes[axis].abs = value;
+				return -1;
+			}
+
+			AxisCalibration& cal = mCalibration[axis];
+			cal.raw				 = value;
+			if(cal.radialPartner < 0)
+			{
+				mState.mAxes[axis].abs = _calibrate(cal, value);
+				return -1;
+			}
+
+			_applyRadialDeadZone(axis, cal.radialPartner);
+			return cal.radialPartner;
+		}
+
+		/**
+		@remarks
+			Backends call this after _setAxis to find out if the axis changed enough to be
+			reported (see setAxisSensitivity). Returning true marks the value as delivered
+		*/
+		inline bool _axisChanged(int axis)
+		{
+			if((std::size_t)axis >= mAxisDelivered.size())
+				mAxisDelivered.resize(mState.mAxes.size(), 0);
+
+			std::int32_t value = mState.mAxes[axis].abs;
+			std::int32_t delta = value - mAxisDelivered[axis];
+			if(delta == 0)
+				return false;
+
+			if(delta > mAxisSensitivity || -delta > mAxisSensitivity
+			   || value == 0 || value == MIN_AXIS || value == MAX_AXIS)
+			{
+				mAxisDelivered[axis] = value;
+				return true;
+			}
+
+			return false;
+		}
+
+		/**
+		@remarks
+			Backends call this at the start of capture, to forget the previous frame's changes.
+			Also sizes the masks to the current number of buttons and axes
+		*/
+		void _beginFrame()
+		{
+			if(mPressedButtons.size() != mState.mButtons.size())
+			{
+				mPressedButtons.resize(mState.mButtons.size());
+				mReleasedButtons.resize(mState.mButtons.size());
+			}
+			if(mMovedAxes.size() != mState.mAxes.size())
+				mMovedAxes.resize(mState.mAxes.size());
+
+			mPressedButtons.reset();
+			mReleasedButtons.reset();
+			mMovedAxes.reset();
+		}
+
+		//! Recalculates both axes of a radial dead zone pair from their raw values
+		void _applyRadialDeadZone(int axisX, int axisY);
+
+		//! Makes sure the calibration of the axis exists, raises an exception for invalid axes
+		AxisCalibration& _getCalibration(int axis);
+
+		//! Per axis calibration, axes past the end are passed through unchanged
+		std::vector<AxisCalibration> mCalibration;
+
 		//! Number of sliders
 		int mSliders;
 
@@ -249,6 +480,20 @@ namespace OIS
 
 		//! Adjustment factor for orientation vector accuracy
 		float mVector3Sensitivity;
+
+		//! Change an axis needs before generating events
+		int mAxisSensitivity;
+
+		//! See getDroppedFrames
+		unsigned int mDroppedFrames;
+
+		//! Buttons that went down/up and axes that moved during the current capture
+		BitSet mPressedButtons;
+		BitSet mReleasedButtons;
+		BitSet mMovedAxes;
+
+		//! Last axis values reported to listeners, see _axisChanged
+		std::vector<std::int32_t> mAxisDelivered;
 	};
 }
 #endif
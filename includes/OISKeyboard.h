@@ -27,6 +27,7 @@ following restrictions:
 #define OIS_Keyboard_H
 #include "OISObject.h"
 #include "OISEvents.h"
+#include "OISBitSet.h"
 
 namespace OIS
 {
@@ -180,14 +181,83 @@ namespace OIS
 		KC_MEDIASELECT	= 0xED, // Media Select
 	};
 
+	//! One bit per KeyCode
+	typedef FixedBitSet<256> KeyMask;
+
+	/**
+		A key combination, precompiled into masks so checking it against the keyboard state
+		costs a few AND/CMP per 64 keys. Build it once, then test it every frame with
+		Keyboard::isChordDown or matches(keyboard->getKeyStates()).
+	*/
+	class _OISExport KeyChord
+	{
+	public:
+		KeyChord() { }
+
+		//! Convenience constructor, KC_UNASSIGNED entries are skipped
+		explicit KeyChord(KeyCode a, KeyCode b = KC_UNASSIGNED, KeyCode c = KC_UNASSIGNED, KeyCode d = KC_UNASSIGNED)
+		{
+			require(a).require(b).require(c).require(d);
+		}
+
+		//! Adds a key that has to be down
+		KeyChord& require(KeyCode key)
+		{
+			if(key != KC_UNASSIGNED)
+			{
+				mRequired.set(key);
+				mForbidden.set(key, false);
+			}
+			return *this;
+		}
+
+		//! Adds a key that has to be up
+		KeyChord& forbid(KeyCode key)
+		{
+			if(key != KC_UNASSIGNED && !mRequired.test(key))
+				mForbidden.set(key);
+			return *this;
+		}
+
+		/**
+		@remarks
+			Forbids every Ctrl, Shift, Alt and Win key that is not required, so Ctrl+S does
+			not also match while Ctrl+Shift+S is held
+		*/
+		KeyChord& forbidOtherModifiers()
+		{
+			return forbid(KC_LCONTROL).forbid(KC_RCONTROL).forbid(KC_LSHIFT).forbid(KC_RSHIFT).forbid(KC_LMENU).forbid(KC_RMENU).forbid(KC_LWIN).forbid(KC_RWIN);
+		}
+
+		//! Returns true if every required key is down and every forbidden key up in keys
+		bool matches(const KeyMask& keys) const
+		{
+			const std::uint64_t* state	   = keys.data();
+			const std::uint64_t* required  = mRequired.data();
+			const std::uint64_t* forbidden = mForbidden.data();
+
+			std::uint64_t mismatch = 0;
+			for(std::size_t w = 0; w < KeyMask::Words; ++w)
+				mismatch |= (~state[w] & required[w]) | (state[w] & forbidden[w]);
+			return mismatch == 0;
+		}
+
+		const KeyMask& getRequired() const { return mRequired; }
+		const KeyMask& getForbidden() const { return mForbidden; }
+
+	protected:
+		KeyMask mRequired;
+		KeyMask mForbidden;
+	};
+
 	/**
 		Specialised for key events
 	*/
 	class _OISExport KeyEvent : public EventArg
 	{
 	public:
-		KeyEvent(Object* obj, KeyCode kc, unsigned int txt) :
-		 EventArg(obj), key(kc), text(txt) { }
+		KeyEvent(Object* obj, KeyCode kc, unsigned int txt, std::uint64_t time = 0) :
+		 EventArg(obj, time), key(kc), text(txt) { }
 		virtual ~KeyEvent() { }
 
 		//! KeyCode of event
@@ -196,6 +266,27 @@ namespace OIS
 		unsigned int text;
 	};
 
+	/**
+		Specialised for text input. One event carries everything committed at once, be
+		it a single key press or a whole input method (IME) composition. The text is
+		only valid for the duration of the callback, copy what you need to keep.
+	*/
+	class _OISExport TextEvent : public EventArg
+	{
+	public:
+		TextEvent(Object* obj, const char* utf8Text, std::size_t utf8Len, const std::uint32_t* utf32Text, std::size_t utf32Len, std::uint64_t time = 0) :
+		 EventArg(obj, time), utf8(utf8Text), utf8Length(utf8Len), utf32(utf32Text), utf32Length(utf32Len) { }
+		virtual ~TextEvent() { }
+
+		//! Committed text as UTF-8 (not null terminated)
+		const char* utf8;
+		std::size_t utf8Length;
+
+		//! The same text as UTF-32 code points, invalid input replaced by U+FFFD
+		const std::uint32_t* utf32;
+		std::size_t utf32Length;
+	};
+
 	/**
 		To recieve buffered keyboard input, derive a class from this, and implement the
 		methods here. Then set the call back to your Keyboard instance with Keyboard::setEventCallback
@@ -206,6 +297,18 @@ namespace OIS
 		virtual ~KeyListener() { }
 		virtual bool keyPressed(const KeyEvent& arg)  = 0;
 		virtual bool keyReleased(const KeyEvent& arg) = 0;
+
+		/**
+		@remarks
+			Called once per text commit (after the keyPressed that produced it, if any) unless
+			the text translation mode is Off. Prefer this over KeyEvent::text for text entry,
+			it also receives input method compositions and multi character commits
+		*/
+		virtual bool textEntered(const TextEvent& arg)
+		{
+			OIS_UNUSED(arg);
+			return true;
+		}
 	};
 
 	/**
@@ -273,6 +376,10 @@ namespace OIS
 			KeyCode to convert
 		@returns
 			The string as determined from the current locale
+		@notes
+			On Linux the names are interned when the keyboard is initialised (and whenever
+			the keymap changes), so the returned reference stays valid for the lifetime
+			of the keyboard and lookups neither allocate nor talk to the X server
 		*/
 		virtual const std::string& getAsString(KeyCode kc) = 0;
 
@@ -302,9 +409,9 @@ namespace OIS
 		@param str
 			string to convert
 		@returns
-			The matching KeyCode
+			The matching KeyCode, or KC_UNASSIGNED when the name is unknown
 		*/
-		virtual OIS::KeyCode getAsKeyCode(std::string str) = 0;
+		virtual OIS::KeyCode getAsKeyCode(const std::string& str) = 0;
 
 		/**
 		@remarks
@@ -325,11 +432,114 @@ namespace OIS
 		*/
 		virtual void copyKeyStates(char keys[256]) const = 0;
 
+		/**
+		@remarks
+			Returns the state of every key, one bit per KeyCode. Copy the result to keep a
+			snapshot (it is 4 x 64 bit words, see KeyMask::data)
+		*/
+		virtual const KeyMask& getKeyStates() const;
+
+		/** @remarks Returns true if any of the keys in the mask is down */
+		bool isAnyKeyDown(const KeyMask& keys) const;
+
+		/** @remarks Returns true if all of the keys in the mask are down */
+		bool areAllKeysDown(const KeyMask& keys) const;
+
+		/** @remarks Returns true if the chord's required keys are down and its forbidden keys up */
+		bool isChordDown(const KeyChord& chord) const { return chord.matches(getKeyStates()); }
+
+		/**
+		@remarks
+			Returns true if the key went down during the last capture (it may have been
+			released again since). Works in both buffered and non buffered mode
+		*/
+		bool wasPressed(KeyCode key) const { return mPressedKeys.test(key); }
+
+		/** @remarks Returns true if the key went up during the last capture */
+		bool wasReleased(KeyCode key) const { return mReleasedKeys.test(key); }
+
+		/**
+		@remarks
+			Keys that went down during the last capture. Iterate over them with
+			getPressedKeys().setBits() instead of checking all 256 keys
+		*/
+		const KeyMask& getPressedKeys() const { return mPressedKeys; }
+
+		/** @remarks Keys that went up during the last capture */
+		const KeyMask& getReleasedKeys() const { return mReleasedKeys; }
+
+		/**
+		@remarks
+			Validating UTF-8 decoder. Overlong encodings, surrogates, values past U+10FFFF and
+			truncated sequences each decode to one U+FFFD replacement character
+		@param utf8
+			Text to decode
+		@param length
+			Number of bytes in utf8
+		@param utf32
+			Receives the code points, needs room for up to length of them
+		@param maxChars
+			Capacity of utf32, decoding stops once it is full
+		@returns
+			Number of code points written
+		*/
+		static std::size_t decodeUTF8(const char* utf8, std::size_t length, std::uint32_t* utf32, std::size_t maxChars);
+
+		/**
+		@remarks
+			Encodes one code point as UTF-8, invalid code points become U+FFFD
+		@param utf8
+			Receives the encoded bytes, needs room for 4 of them
+		@returns
+			Number of bytes written
+		*/
+		static std::size_t encodeUTF8(std::uint32_t codePoint, char* utf8);
+
+		/** @copydoc Object::_clearFrame */
+		virtual void _clearFrame() { _beginFrame(); }
+
 	protected:
 		Keyboard(const std::string& vendor, bool buffered, int devID, InputManager* creator) :
 		 Object(vendor, OISKeyboard, buffered, devID, creator),
 		 mModifiers(0), mListener(0), mTextMode(Unicode) { }
 
+		//! Backends call this at the start of capture, to forget the previous frame's changes
+		void _beginFrame()
+		{
+			mPressedKeys.reset();
+			mReleasedKeys.reset();
+		}
+
+		/**
+		@remarks
+			Decodes a committed UTF-8 string into mTextUTF32, queues one TextEntered InputEvent
+			per code point and calls KeyListener::textEntered once with the whole string
+		@param notify
+			False to only queue the events, after a listener asked to stop
+		@returns
+			The listener's result, true when nobody listens (and notify when it is false)
+		*/
+		bool _injectText(const char* utf8, std::size_t length, std::uint64_t time, bool notify = true);
+
+		/**
+		@remarks
+			Layout independent key names for backends without a keymap of their own: the US
+			key cap where there is one (A, 1, [, Space...), otherwise Key_<n>
+		@returns
+			A reference into a static table built on first use, valid for the process lifetime
+		*/
+		static const std::string& _getDefaultKeyName(KeyCode kc);
+
+		//! Reverse of _getDefaultKeyName, KC_UNASSIGNED when the name is not in the table
+		static KeyCode _getDefaultKeyCode(const std::string& name);
+
+		//! Keys that went down/up during the current capture
+		KeyMask mPressedKeys;
+		KeyMask mReleasedKeys;
+
+		//! State of every key. Backends keeping this up to date override getKeyStates to return it
+		mutable KeyMask mKeyStates;
+
 		//! Bit field that holds status of Alt, Ctrl, Shift, Win, CapsLock, and NumLock as well as Left and Right variants
 		unsigned int mModifiers;
 
@@ -338,6 +548,9 @@ namespace OIS
 
 		//! The current translation mode
 		TextTranslationMode mTextMode;
+
+		//! Scratch buffer for _injectText, only grows
+		std::vector<std::uint32_t> mTextUTF32;
 	};
 }
 #endif
@@ -63,9 +63,13 @@ namespace OIS
 		//! Y Axis Component
 		Axis Y;
 
-		//! Z Axis Component
+		/** Z Axis Component, the wheel. 120 per notch, high resolution wheels and smooth
+		scrolling report fractions of a notch as smaller steps */
 		Axis Z;
 
+		//! Horizontal wheel (tilt wheels, trackpads) in the same units as Z, positive is right
+		Axis H;
+
 		//! represents all buttons - bit position indicates button down
 		int buttons;
 
@@ -81,16 +85,26 @@ namespace OIS
 			X.clear();
 			Y.clear();
 			Z.clear();
+			H.clear();
 			buttons = 0;
 		}
 	};
 
+	//! One relative movement as the device reported it, see Mouse::getMotionHistory
+	struct MouseMotion
+	{
+		std::int32_t dx, dy;
+
+		//! Same clock as EventArg::timestamp
+		std::uint64_t timestamp;
+	};
+
 	/** Specialised for mouse events */
 	class _OISExport MouseEvent : public EventArg
 	{
 	public:
-		MouseEvent(Object* obj, const MouseState& ms) :
-		 EventArg(obj), state(ms) { }
+		MouseEvent(Object* obj, const MouseState& ms, std::uint64_t time = 0) :
+		 EventArg(obj, time), state(ms) { }
 		virtual ~MouseEvent() { }
 
 		//! The state of the mouse - including buttons and axes
@@ -139,15 +153,101 @@ namespace OIS
 		/** @remarks Returns the state of the mouse - is valid for both buffered and non buffered mode */
 		const MouseState& getMouseState() const { return mState; }
 
+		/**
+		@remarks
+			Returns true if the button went down during the last capture (it may have been
+			released again since). Works in both buffered and non buffered mode
+		*/
+		bool wasPressed(MouseButtonID button) const { return (mPressedButtons & (1 << button)) != 0; }
+
+		/** @remarks Returns true if the button went up during the last capture */
+		bool wasReleased(MouseButtonID button) const { return (mReleasedButtons & (1 << button)) != 0; }
+
+		/** @remarks Buttons that went down during the last capture, as bits like MouseState::buttons */
+		int getPressedButtons() const { return mPressedButtons; }
+
+		/** @remarks Buttons that went up during the last capture, as bits like MouseState::buttons */
+		int getReleasedButtons() const { return mReleasedButtons; }
+
+		/**
+		@remarks
+			Keeps every relative movement of a capture, in the order the device reported them,
+			next to the summed MouseState. Meant for smoothing and prediction with tablets and
+			high rate mice, which report far more often than frames happen. The array is
+			allocated here; when a capture brings more movements, the rest is added onto the
+			last sample so the sum stays exact
+		@param capacity
+			Samples kept per capture, 0 (the default) disables the history
+		*/
+		void setMotionHistorySize(unsigned int capacity)
+		{
+			mMotionHistory.clear();
+			mMotionHistory.reserve(capacity);
+			mMotionHistorySize = capacity;
+		}
+
+		/**
+		@remarks
+			Returns the movements of the last capture, oldest first. The range is empty while
+			the history is disabled, and on backends which only poll a summed state (Win32, Mac)
+		*/
+		void getMotionHistory(const MouseMotion*& begin, const MouseMotion*& end) const
+		{
+			begin = mMotionHistory.data();
+			end	  = begin + mMotionHistory.size();
+		}
+
+		/** @copydoc Object::_clearFrame */
+		virtual void _clearFrame()
+		{
+			mState.X.rel = mState.Y.rel = mState.Z.rel = mState.H.rel = 0;
+			_beginFrame();
+		}
+
 	protected:
 		Mouse(const std::string& vendor, bool buffered, int devID, InputManager* creator) :
-		 Object(vendor, OISMouse, buffered, devID, creator), mListener(0) { }
+		 Object(vendor, OISMouse, buffered, devID, creator), mListener(0), mPressedButtons(0), mReleasedButtons(0), mMotionHistorySize(0) { }
+
+		//! Backends call this at the start of capture, to forget the previous frame's changes
+		void _beginFrame()
+		{
+			mPressedButtons = mReleasedButtons = 0;
+			mMotionHistory.clear();
+		}
+
+		//! Backends call this for every relative movement, does nothing while the history is disabled
+		void _recordMotion(int dx, int dy, std::uint64_t time)
+		{
+			if(mMotionHistorySize == 0 || (dx == 0 && dy == 0))
+				return;
+
+			if(mMotionHistory.size() < mMotionHistorySize)
+			{
+				MouseMotion motion = { dx, dy, time };
+				mMotionHistory.push_back(motion);
+			}
+			else
+			{
+				MouseMotion& last = mMotionHistory.back();
+				last.dx += dx;
+				last.dy += dy;
+				last.timestamp = time;
+			}
+		}
 
 		//! The state of the mouse
 		MouseState mState;
 
 		//! Used for buffered/actionmapping callback
 		MouseListener* mListener;
+
+		//! Buttons that went down/up during the current capture
+		int mPressedButtons;
+		int mReleasedButtons;
+
+		//! Movements of the current capture, and how many are kept before they are merged
+		std::vector<MouseMotion> mMotionHistory;
+		unsigned int mMotionHistorySize;
 	};
 }
 #endif
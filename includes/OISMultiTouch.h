@@ -90,8 +90,8 @@ namespace OIS
 	class _OISExport MultiTouchEvent : public EventArg
 	{
 	public:
-		MultiTouchEvent(Object* obj, const MultiTouchState& ms) :
-		 EventArg(obj), state(ms) { }
+		MultiTouchEvent(Object* obj, const MultiTouchState& ms, std::uint64_t time = 0) :
+		 EventArg(obj, time), state(ms) { }
 		virtual ~MultiTouchEvent() { }
 
 		//! The state of the touch - including axes
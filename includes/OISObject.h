@@ -28,6 +28,8 @@ following restrictions:
 
 #include "OISPrereqs.h"
 #include "OISInterface.h"
+#include "OISEvents.h"
+#include "OISInputManager.h"
 
 namespace OIS
 {
@@ -70,13 +72,70 @@ namespace OIS
 		/**	@remarks Internal... Do not call this directly. */
 		virtual void _initialize() = 0;
 
+		/**
+		@remarks
+			Internal... Forgets the previous capture's changes (relative axes, pressed/released
+			masks) without touching the device. Used by managers in place of capture for devices
+			they know have no pending input.
+		*/
+		virtual void _clearFrame() { }
+
+		/**
+		@remarks
+			Register/unregister a BatchListener, which receives every event of a capture() in
+			one call (buffered mode only). See BatchListener for which backends fill batches.
+		@param batchListener
+			Send a pointer to a class derived from BatchListener or 0 to clear the callback
+		*/
+		void setBatchCallback(BatchListener* batchListener)
+		{
+			mBatchListener = batchListener;
+			mBatch.clear();
+			if(batchListener)
+				mBatch.reserve(256);
+		}
+
+		/** @remarks Returns currently set batch callback.. or 0 */
+		BatchListener* getBatchCallback() const { return mBatchListener; }
+
 	protected:
 		Object(const std::string& vendor, Type iType, bool buffered, int devID, InputManager* creator) :
 		 mVendor(vendor),
 		 mType(iType),
 		 mBuffered(buffered),
 		 mDevID(devID),
-		 mCreator(creator) { }
+		 mCreator(creator),
+		 mBatchListener(0) { }
+
+		//! Queues an event for the batch listener and the manager's event log, cheap no-op when neither is used
+		inline void _queueEvent(InputEvent::EventType type, int code, int value, std::uint64_t time)
+		{
+			bool logging = mCreator && mCreator->_isLogging();
+			if(logging || (mBatchListener && mBuffered))
+			{
+				InputEvent evt;
+				evt.timestamp = time;
+				evt.value	  = value;
+				evt.code	  = (std::uint16_t)code;
+				evt.type	  = (std::uint16_t)type;
+
+				if(logging)
+					mCreator->_logEvent(this, evt);
+				if(mBatchListener && mBuffered)
+					mBatch.push_back(evt);
+			}
+		}
+
+		//! Hands queued events to the batch listener, call at the end of capture()
+		inline void _flushEvents()
+		{
+			if(!mBatch.empty())
+			{
+				if(mBatchListener)
+					mBatchListener->onEvents(this, &mBatch[0], &mBatch[0] + mBatch.size());
+				mBatch.clear();
+			}
+		}
 
 		//! Vendor name if applicable/known
 		std::string mVendor;
@@ -92,6 +151,10 @@ namespace OIS
 
 		//! The creator who created this object
 		InputManager* mCreator;
+
+		//! Batch callback and its reusable event array
+		BatchListener* mBatchListener;
+		std::vector<InputEvent> mBatch;
 	};
 }
 #endif
@@ -0,0 +1,207 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef OIS_Replay_H
+#define OIS_Replay_H
+
+#include "OISPrereqs.h"
+#include "OISEvents.h"
+#include "OISFactoryCreator.h"
+
+//! Recording file format version
+#define OIS_REPLAY_VERSION 1
+
+//! Number of events the recording file grows by when full
+#define OIS_REPLAY_CHUNK 65536
+
+namespace OIS
+{
+	//! First bytes of a recording, followed by RawEvent records in native byte order
+	struct ReplayFileHeader
+	{
+		//! "OISR"
+		char magic[4];
+		//! OIS_REPLAY_VERSION of the writer
+		std::uint32_t version;
+		//! Number of RawEvent records following the header
+		std::uint64_t count;
+	};
+
+	/**
+		Appends RawEvent records to a file through a memory map, so recording costs a copy
+		per event and a syscall only every few thousand events when the file is grown.
+		InputManager::startRecording uses this to record everything its devices produce.
+		Not supported on Windows.
+	*/
+	class _OISExport EventRecorder
+	{
+	public:
+		/**
+		@remarks
+			Creates (or truncates) the file. Raises an exception if it cannot be created or mapped
+		*/
+		explicit EventRecorder(const std::string& fileName);
+
+		/** @remarks Unmaps and truncates the file to the recorded events */
+		~EventRecorder();
+
+		//! Appends one event
+		void append(const RawEvent& evt)
+		{
+			if(mCount == mCapacity)
+				_grow();
+
+			mEvents[mCount] = evt;
+			mHeader->count	= ++mCount;
+		}
+
+		//! Number of events written so far
+		std::uint64_t getCount() const { return mCount; }
+
+	protected:
+		//! Extends the file and remaps it
+		void _grow();
+
+		int mFd;
+		ReplayFileHeader* mHeader;
+		RawEvent* mEvents;
+		std::uint64_t mCount;
+		std::uint64_t mCapacity;
+
+	private:
+		// Prevent copying.
+		EventRecorder(const EventRecorder&);
+		EventRecorder& operator=(const EventRecorder&);
+	};
+
+	/**
+		Plays back a file written by EventRecorder (see InputManager::startRecording). Add it
+		to an InputManager with addFactoryCreator, and it offers one Keyboard, Mouse or JoyStick
+		(vendor "Replay") for every device found in the recording. They behave like real
+		devices: capture() updates their state and calls the listeners with the events which
+		are due, so applications can be driven without X or /dev/input. Not supported on Windows.
+	*/
+	class _OISExport ReplayFactoryCreator : public FactoryCreator
+	{
+	public:
+		/**
+		@remarks
+			Opens and maps the recording. Raises an exception if it is missing or invalid
+		@param fileName
+			File written by EventRecorder
+		@param speed
+			Playback speed, 1 replays at the original pace, 2 twice as fast, etc. 0 or less
+			delivers the whole recording as fast as capture() is called
+		*/
+		explicit ReplayFactoryCreator(const std::string& fileName, float speed = 1.0f);
+		~ReplayFactoryCreator();
+
+		//FactoryCreator Overrides
+		/** @copydoc FactoryCreator::deviceList */
+		DeviceList freeDeviceList();
+
+		/** @copydoc FactoryCreator::totalDevices */
+		int totalDevices(Type iType);
+
+		/** @copydoc FactoryCreator::freeDevices */
+		int freeDevices(Type iType);
+
+		/** @copydoc FactoryCreator::vendorExist */
+		bool vendorExist(Type iType, const std::string& vendor);
+
+		/** @copydoc FactoryCreator::createObject */
+		Object* createObject(InputManager* creator, Type iType, bool bufferMode, const std::string& vendor = "");
+
+		/** @copydoc FactoryCreator::destroyObject */
+		void destroyObject(Object* obj);
+
+		/** @remarks Changes the playback speed, see constructor */
+		void setSpeed(float speed);
+
+		/** @remarks Returns the playback speed */
+		float getSpeed() const { return mSpeed; }
+
+		/** @remarks Starts playback from the beginning on the next capture() */
+		void restart();
+
+		/** @remarks Returns true once every created device has played all of its events */
+		bool isFinished() const;
+
+		/** @remarks Number of events in the recording */
+		std::uint64_t getEventCount() const { return mCount; }
+
+		/** @remarks Internal... Events of the recording */
+		const RawEvent* _getEvents() const { return mEvents; }
+
+		/** @remarks Internal... Playback time of an event, see mPlayTimes */
+		std::uint64_t _getPlayTime(std::uint64_t index) const { return mPlayTimes[index]; }
+
+		/** @remarks Internal... Playback time up to which events should be delivered now */
+		std::uint64_t _getReplayTime();
+
+		//! Internal... A device found in the recording
+		struct ReplayDevice
+		{
+			Type type;
+			int id;
+			//! Number of components seen for joysticks
+			int buttons, axes, povs;
+			//! Index of the next event to look at
+			std::uint64_t cursor;
+			//! Created device, 0 while free
+			Object* object;
+		};
+
+	protected:
+		typedef std::vector<ReplayDevice> ReplayDeviceList;
+		ReplayDeviceList mDevices;
+
+		int mFd;
+		std::size_t mMapSize;
+		void* mMap;
+		const RawEvent* mEvents;
+		std::uint64_t mCount;
+
+		/**
+			Nanoseconds from the start of the recording at which each event is played. Devices
+			may stamp events with different clocks (X server time, CLOCK_MONOTONIC), so only the
+			steps between two events of the same device are trusted. The result never goes
+			backwards, and events without a timestamp play with the one before them.
+		*/
+		std::vector<std::uint64_t> mPlayTimes;
+
+		float mSpeed;
+		//! Wall clock (ns) and playback time at which playback (re)started, mStarted is false until then
+		bool mStarted;
+		std::uint64_t mStartTime;
+		std::uint64_t mStartEventTime;
+
+	private:
+		// Prevent copying.
+		ReplayFactoryCreator(const ReplayFactoryCreator&);
+		ReplayFactoryCreator& operator=(const ReplayFactoryCreator&);
+	};
+}
+#endif //OIS_Replay_H
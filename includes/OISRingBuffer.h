@@ -0,0 +1,148 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef OIS_RingBuffer_H
+#define OIS_RingBuffer_H
+
+#include "OISPrereqs.h"
+#include <atomic>
+#include <cstring>
+
+namespace OIS
+{
+	/**
+		Lock-free single producer / single consumer FIFO of trivially copyable entries.
+		One thread may write while another reads without any locking; capacity is rounded
+		up to a power of two and allocated once at construction.
+	*/
+	template <typename T>
+	class RingBuffer
+	{
+	public:
+		explicit RingBuffer(unsigned int numEntries)
+		{
+			mSize	= roundUpToNextPowerOf2(numEntries);
+			mMask	= mSize - 1;
+			mBuffer = new T[mSize];
+			mWriteIndex.store(0, std::memory_order_relaxed);
+			mReadIndex.store(0, std::memory_order_relaxed);
+		}
+
+		~RingBuffer()
+		{
+			delete[] mBuffer;
+		}
+
+		static unsigned int roundUpToNextPowerOf2(unsigned int n)
+		{
+			unsigned int size = 1;
+			while(size < n)
+				size <<= 1;
+			return size;
+		}
+
+		//! Total number of entries the buffer can hold
+		unsigned int capacity() const { return mSize; }
+
+		//! Number of entries ready to be read (consumer side)
+		unsigned int readAvailable() const
+		{
+			return mWriteIndex.load(std::memory_order_acquire) - mReadIndex.load(std::memory_order_relaxed);
+		}
+
+		//! Number of entries that can be written without overwriting (producer side)
+		unsigned int writeAvailable() const
+		{
+			return mSize - (mWriteIndex.load(std::memory_order_relaxed) - mReadIndex.load(std::memory_order_acquire));
+		}
+
+		/**
+		@remarks
+			Producer side. Copies up to numEntries from data, returns the number written
+			(less than requested when the buffer is full)
+		*/
+		unsigned int write(const T* data, unsigned int numEntries)
+		{
+			unsigned int writeIndex = mWriteIndex.load(std::memory_order_relaxed);
+			unsigned int available	= mSize - (writeIndex - mReadIndex.load(std::memory_order_acquire));
+			if(numEntries > available)
+				numEntries = available;
+
+			unsigned int index = writeIndex & mMask;
+			unsigned int first = mSize - index;
+			if(first > numEntries)
+				first = numEntries;
+
+			std::memcpy(&mBuffer[index], data, sizeof(T) * first);
+			std::memcpy(&mBuffer[0], data + first, sizeof(T) * (numEntries - first));
+
+			mWriteIndex.store(writeIndex + numEntries, std::memory_order_release);
+			return numEntries;
+		}
+
+		/**
+		@remarks
+			Consumer side. Copies up to numEntries into data, returns the number read
+		*/
+		unsigned int read(T* data, unsigned int numEntries)
+		{
+			unsigned int readIndex = mReadIndex.load(std::memory_order_relaxed);
+			unsigned int available = mWriteIndex.load(std::memory_order_acquire) - readIndex;
+			if(numEntries > available)
+				numEntries = available;
+
+			unsigned int index = readIndex & mMask;
+			unsigned int first = mSize - index;
+			if(first > numEntries)
+				first = numEntries;
+
+			std::memcpy(data, &mBuffer[index], sizeof(T) * first);
+			std::memcpy(data + first, &mBuffer[0], sizeof(T) * (numEntries - first));
+
+			mReadIndex.store(readIndex + numEntries, std::memory_order_release);
+			return numEntries;
+		}
+
+		//! Consumer side. Discards everything currently queued
+		void flush()
+		{
+			mReadIndex.store(mWriteIndex.load(std::memory_order_acquire), std::memory_order_release);
+		}
+
+	private:
+		// Prevent copying.
+		RingBuffer(const RingBuffer&);
+		RingBuffer& operator=(const RingBuffer&);
+
+		T* mBuffer;
+		unsigned int mSize;
+		unsigned int mMask;
+
+		//! Free running indices, only ever masked when touching mBuffer
+		std::atomic<unsigned int> mWriteIndex;
+		std::atomic<unsigned int> mReadIndex;
+	};
+}
+#endif //OIS_RingBuffer_H
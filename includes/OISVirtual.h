@@ -0,0 +1,226 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef OIS_Virtual_H
+#define OIS_Virtual_H
+
+#include "OISPrereqs.h"
+#include "OISFactoryCreator.h"
+#include "OISKeyboard.h"
+#include "OISMouse.h"
+#include "OISJoyStick.h"
+
+namespace OIS
+{
+	/**
+		Keyboard without hardware. Injected events are queued and delivered by capture()
+		exactly like a real keyboard delivers them: state, KeyListener and BatchListener.
+	*/
+	class _OISExport VirtualKeyboard : public Keyboard
+	{
+	public:
+		VirtualKeyboard(InputManager* creator, bool buffered, int devID, const std::string& vendor = "Virtual");
+
+		//! Queues a key press with the given translated text (0 for none)
+		void injectKeyDown(KeyCode kc, unsigned int text = 0, std::uint64_t time = 0);
+
+		//! Queues a key release
+		void injectKeyUp(KeyCode kc, std::uint64_t time = 0);
+
+		//! Queues a KeyPressed, KeyReleased or TextEntered InputEvent, other types are ignored
+		void inject(const InputEvent& evt);
+
+		/** @copydoc Keyboard::isKeyDown */
+		virtual bool isKeyDown(KeyCode key) const;
+
+		/** @copydoc Keyboard::getAsString */
+		virtual const std::string& getAsString(KeyCode kc);
+
+		/** @copydoc Keyboard::getAsKeyCode */
+		virtual KeyCode getAsKeyCode(const std::string& str);
+
+		/** @copydoc Keyboard::copyKeyStates */
+		virtual void copyKeyStates(char keys[256]) const;
+
+		/** @copydoc Keyboard::getKeyStates */
+		virtual const KeyMask& getKeyStates() const { return mKeyStates; }
+
+		/** @copydoc Object::setBuffered */
+		virtual void setBuffered(bool buffered);
+
+		/** @copydoc Object::capture */
+		virtual void capture();
+
+		/** @copydoc Object::queryInterface */
+		virtual Interface* queryInterface(Interface::IType type);
+
+		/** @copydoc Object::_initialize */
+		virtual void _initialize();
+
+		//! Internal... applies one queued event, returns the listener's result
+		bool _processEvent(const InputEvent& evt);
+
+	protected:
+		std::vector<InputEvent> mPending;
+	};
+
+	/**
+		Mouse without hardware. Injected events are queued and delivered by capture(), with
+		all motion of a capture combined into one mouseMoved like a real mouse. Each injected
+		X or Y MouseMoved event is one sample of the motion history.
+	*/
+	class _OISExport VirtualMouse : public Mouse
+	{
+	public:
+		VirtualMouse(InputManager* creator, bool buffered, int devID, const std::string& vendor = "Virtual");
+
+		//! Queues relative motion, zero components are skipped
+		void injectMove(int dx, int dy, int dz = 0, std::uint64_t time = 0);
+
+		//! Queues a button press, ids past MB_Button7 are ignored
+		void injectButtonDown(MouseButtonID id, std::uint64_t time = 0);
+
+		//! Queues a button release, ids past MB_Button7 are ignored
+		void injectButtonUp(MouseButtonID id, std::uint64_t time = 0);
+
+		//! Queues a MouseMoved (codes 0-3), MousePressed or MouseReleased (up to MB_Button7) InputEvent, anything else is ignored
+		void inject(const InputEvent& evt);
+
+		/** @copydoc Object::setBuffered */
+		virtual void setBuffered(bool buffered);
+
+		/** @copydoc Object::capture */
+		virtual void capture();
+
+		/** @copydoc Object::queryInterface */
+		virtual Interface* queryInterface(Interface::IType type);
+
+		/** @copydoc Object::_initialize */
+		virtual void _initialize();
+
+		//! Internal... applies one queued event, returns the listener's result
+		bool _processEvent(const InputEvent& evt);
+
+	protected:
+		std::vector<InputEvent> mPending;
+		bool mMoved;
+		std::uint64_t mMoveTime;
+	};
+
+	/**
+		JoyStick without hardware, with a fixed number of buttons, axes and POVs. Injected
+		events are queued and delivered by capture(), with axes combined into one axisMoved
+		per axis and capture like a real joystick.
+	*/
+	class _OISExport VirtualJoyStick : public JoyStick
+	{
+	public:
+		VirtualJoyStick(InputManager* creator, bool buffered, int devID, int buttons, int axes, int povs, const std::string& vendor = "Virtual");
+
+		//! Queues a button press
+		void injectButtonDown(int button, std::uint64_t time = 0);
+
+		//! Queues a button release
+		void injectButtonUp(int button, std::uint64_t time = 0);
+
+		//! Queues an absolute axis position (JoyStick::MIN_AXIS to JoyStick::MAX_AXIS)
+		void injectAxis(int axis, int value, std::uint64_t time = 0);
+
+		//! Queues a POV direction (Pov bits)
+		void injectPov(int pov, int direction, std::uint64_t time = 0);
+
+		//! Queues a joystick InputEvent, other types and out of range components are ignored
+		void inject(const InputEvent& evt);
+
+		/** @copydoc Object::setBuffered */
+		virtual void setBuffered(bool buffered);
+
+		/** @copydoc Object::capture */
+		virtual void capture();
+
+		/** @copydoc Object::queryInterface */
+		virtual Interface* queryInterface(Interface::IType type);
+
+		/** @copydoc Object::_initialize */
+		virtual void _initialize();
+
+		//! Internal... applies one queued event, returns the listener's result
+		bool _processEvent(const InputEvent& evt);
+
+	protected:
+		std::vector<InputEvent> mPending;
+		std::vector<std::uint64_t> mAxisTime;
+	};
+
+	/**
+		Factory of virtual devices (vendor "Virtual"), for benchmarks and tests on machines
+		without X or /dev/input. Add it to any InputManager with addFactoryCreator, create the
+		devices through the manager as usual and cast them to VirtualKeyboard, VirtualMouse or
+		VirtualJoyStick to inject events.
+	*/
+	class _OISExport VirtualFactoryCreator : public FactoryCreator
+	{
+	public:
+		/**
+		@remarks
+			Offers the given number of devices of each type
+		@param joyButtons, joyAxes, joyPovs
+			Layout of the virtual joysticks
+		*/
+		VirtualFactoryCreator(int keyboards = 1, int mice = 1, int joySticks = 1, int joyButtons = 32, int joyAxes = 8, int joyPovs = 4);
+		~VirtualFactoryCreator();
+
+		//FactoryCreator Overrides
+		/** @copydoc FactoryCreator::deviceList */
+		DeviceList freeDeviceList();
+
+		/** @copydoc FactoryCreator::totalDevices */
+		int totalDevices(Type iType);
+
+		/** @copydoc FactoryCreator::freeDevices */
+		int freeDevices(Type iType);
+
+		/** @copydoc FactoryCreator::vendorExist */
+		bool vendorExist(Type iType, const std::string& vendor);
+
+		/** @copydoc FactoryCreator::createObject */
+		Object* createObject(InputManager* creator, Type iType, bool bufferMode, const std::string& vendor = "");
+
+		/** @copydoc FactoryCreator::destroyObject */
+		void destroyObject(Object* obj);
+
+	protected:
+		//! Device slots, index is the device id (0 while free)
+		std::vector<Object*> mKeyboards;
+		std::vector<Object*> mMice;
+		std::vector<Object*> mJoySticks;
+
+		int mJoyButtons, mJoyAxes, mJoyPovs;
+
+		//! Returns the slots for the type, or 0
+		std::vector<Object*>* _getSlots(Type iType);
+	};
+}
+#endif //OIS_Virtual_H
@@ -37,8 +37,18 @@ namespace OIS
 	{
 	public:
 		static bool isJoyStick(int deviceID, JoyStickInfo& js);
-		static bool isMouse(int) { return false; }
-		static bool isKeyboard(int) { return false; }
+
+		//! True for devices with relative X/Y axes and a left button
+		static bool isMouse(int deviceID);
+
+		//! True for devices with the letter keys and a space bar (keyboards, arcade encoders)
+		static bool isKeyboard(int deviceID);
+
+		//! Opens every /dev/input/event# keyboard and mouse, devices which are both appear in both lists
+		static void scanKeyboardsAndMice(EventDeviceInfoList& keyboards, EventDeviceInfoList& mice);
+
+		//! Closes every device of the list and empties it
+		static void closeDevices(EventDeviceInfoList& devices);
 
 		//Double pointer is so that we can set the value of the sent pointer
 		static void enumerateForceFeedback(int deviceID, LinuxForceFeedback** ff);
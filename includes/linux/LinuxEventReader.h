@@ -0,0 +1,87 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#ifndef _LINUX_EVENTREADER_H_EADER_
+#define _LINUX_EVENTREADER_H_EADER_
+
+#include "linux/LinuxPrereqs.h"
+#include "OISRingBuffer.h"
+#include <linux/input.h>
+#include <atomic>
+
+//Older kernel headers only expose the timeval member
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+namespace OIS
+{
+	/**
+		Reads input_events from an evdev node, switching the node's event clock to
+		CLOCK_MONOTONIC so timestamps match the rest of OIS. Normally this is a plain non blocking read
+		from capture(). When the manager runs its input thread, the thread drains the node
+		into a lock-free ring with _fill() and read() pops from that ring instead. If that ring
+		overflows, read() reports a SYN_DROPPED just like the kernel does for its own buffer.
+	*/
+	class LinuxEventReader
+	{
+	public:
+		explicit LinuxEventReader(int fd);
+		~LinuxEventReader();
+
+		//! The evdev file descriptor
+		int getFd() const { return mFd; }
+
+		//! Reads up to count events, returns the number read (0 when nothing is pending)
+		int read(input_event* events, int count);
+
+		//! Kernel timestamp of an event in nanoseconds (CLOCK_MONOTONIC, see constructor)
+		static std::uint64_t getTimestamp(const input_event& ev)
+		{
+			return std::uint64_t(ev.input_event_sec) * 1000000000ull + std::uint64_t(ev.input_event_usec) * 1000ull;
+		}
+
+		//! Internal method, switches between direct reads and the input thread's ring
+		void _setThreaded(bool threaded);
+		bool _isThreaded() const { return mRing != 0; }
+
+		//! Internal method, called from the input thread. Returns true if anything was queued
+		bool _fill();
+
+	protected:
+		int mFd;
+		RingBuffer<input_event>* mRing;
+
+		//! Set by the input thread when the ring overflowed, it then discards events until read() reports it
+		std::atomic<bool> mOverflow;
+
+	private:
+		// Prevent copying.
+		LinuxEventReader(const LinuxEventReader&);
+		LinuxEventReader& operator=(const LinuxEventReader&);
+	};
+}
+#endif //_LINUX_EVENTREADER_H_EADER_
@@ -30,6 +30,9 @@ following restrictions:
 #include "OISFactoryCreator.h"
 #include "OISInputManager.h"
 #include <X11/Xlib.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 namespace OIS
 {
@@ -65,6 +68,12 @@ namespace OIS
 		/** @copydoc FactoryCreator::destroyObject */
 		void destroyObject(Object* obj);
 
+		/** @copydoc InputManager::captureAll */
+		void captureAll();
+
+		/** @copydoc InputManager::waitForInput */
+		bool waitForInput(int timeoutMs);
+
 		//Internal Items
 		//! Method for retrieving the XWindow Handle
 		Window _getWindow() { return window; }
@@ -79,16 +88,84 @@ namespace OIS
 		//! Internal method, used for flaggin mouse as available/unavailable for creation
 		void _setMouseUsed(bool used) { mouseUsed = used; }
 
+		//! Internal method, adds a device's file descriptor to the capture set
+		void _registerDevice(int fd, Object* obj);
+
+		//! Internal method, removes a device's file descriptor from the capture set
+		void _unregisterDevice(int fd);
+
+		/**
+		@remarks
+			Internal method, adds an evdev device to the capture set. When the input thread
+			is enabled the reader is handed to that thread instead of being read in capture.
+		*/
+		void _registerReader(LinuxEventReader* reader, Object* obj);
+
+		//! Internal method, removes an evdev device from the capture set or input thread
+		void _unregisterReader(LinuxEventReader* reader);
+
+		/**
+		@remarks
+			Internal method, converts an X server timestamp (32bit milliseconds of the server's
+			CLOCK_MONOTONIC) into OIS nanoseconds. Falls back to the current time for servers
+			whose clock obviously does not match ours (remote displays).
+		*/
+		static std::uint64_t _getXTimestamp(Time time);
+
+		/**
+		@remarks
+			Internal method, returns the X connection shared by the X keyboard and mouse, opening
+			it for the first of them. Every device must hand it back with _releaseXDisplay
+		*/
+		Display* _acquireXDisplay(Object* device);
+
+		//! Internal method, forgets a device of the shared X connection and closes it after the last one
+		void _releaseXDisplay(Object* device);
+
+		/**
+		@remarks
+			Internal method, adds and removes event mask bits of the window. The keyboard and mouse
+			share one connection, whose mask XSelectInput replaces, so each only changes its own bits
+		@returns
+			False if X rejected the window
+		*/
+		bool _selectXInput(long add, long remove = 0);
+
+		/**
+		@remarks
+			Internal method, reads everything pending on the shared X connection in one pass and
+			hands each event to the device it belongs to. The devices apply their own events
+			during their capture, so capturing one never steals or dispatches the other's input
+		*/
+		void _pumpXEvents();
+
 	protected:
 		//! internal class method for dealing with param list
 		void _parseConfigSettings(ParamList& paramList);
 		//! internal class method for finding attached devices
 		void _enumerateDevices();
 
+		//! Waits up to timeoutMs on the epoll set, captures the devices with input and clears the others
+		bool _captureReady(int timeoutMs);
+
+		//! True if the device is read by the input thread rather than through the epoll set
+		bool _isThreadedDevice(Object* obj) const;
+
+		//! Body of the input thread, drains evdev devices into their rings
+		void _inputThread();
+
 		//! List of unused joysticks ready to be used
 		JoyStickInfoList unusedJoyStickList;
 		//! Number of joysticks found
 		char joySticks;
+		//! Start joystick axes with the driver's flat as dead zone (linux_joystick_flat)
+		bool mJoyStickFlat;
+
+		//! evdev keyboards and mice used instead of X (linux_evdev_input), and whether to grab them
+		//! (linux_evdev_grab, never applied to nodes that are both keyboard and mouse)
+		bool mEventInput, mEventGrab;
+		EventDeviceInfoList unusedEventKeyboards, unusedEventMice;
+		int eventKeyboards, eventMice;
 
 		//! Used to know if we used up keyboard
 		bool keyboardUsed;
@@ -103,6 +180,40 @@ namespace OIS
 		bool grabMouse, grabKeyboard;
 		bool mGrabs;
 		bool hideMouse;
+		bool rawMouse;
+
+		//! epoll set covering every evdev fd and the X connection fd
+		int mEpollFd;
+
+		//! Grab state seen by the last captureAll, a change skips the wait so devices regrab at once
+		bool mCapturedGrabs;
+
+		//! The X connection shared by the X keyboard and mouse (0 while neither exists)
+		Display* mXDisplay;
+
+		//! Union of the event masks the X devices selected on the window
+		long mXEventMask;
+
+		//! Devices the X events are demultiplexed to
+		LinuxKeyboard* mXKeyboard;
+		LinuxMouse* mXMouse;
+
+		//! Input thread settings (linux_input_thread), only evdev devices are read by the thread
+		bool mThreaded;
+		std::thread mInputThread;
+		std::atomic<bool> mThreadRunning;
+
+		//! Guards mThreadedDevices against the input thread while devices come and go
+		std::mutex mThreadMutex;
+
+		//! epoll set the input thread sleeps on, and eventfds to wake it and to report new data
+		int mThreadEpollFd;
+		int mThreadWakeFd;
+		int mThreadReadyFd;
+
+		//! Devices being drained by the input thread
+		typedef std::vector<std::pair<Object*, LinuxEventReader*>> ThreadedDeviceList;
+		ThreadedDeviceList mThreadedDevices;
 	};
 }
 #endif
@@ -27,6 +27,7 @@ following restrictions:
 #define _LINUX_JOYSTICK_H_EADER_
 
 #include "linux/LinuxPrereqs.h"
+#include "linux/LinuxEventReader.h"
 #include "OISJoyStick.h"
 
 namespace OIS
@@ -39,7 +40,7 @@ namespace OIS
 	class LinuxJoyStick : public JoyStick
 	{
 	public:
-		LinuxJoyStick(InputManager* creator, bool buffered, const JoyStickInfo& js);
+		LinuxJoyStick(InputManager* creator, bool buffered, const JoyStickInfo& js, bool flatDeadZone);
 		virtual ~LinuxJoyStick();
 
 		/** @copydoc Object::setBuffered */
@@ -65,11 +66,44 @@ namespace OIS
 		static void _clearJoys(JoyStickInfoList& joys);
 
 	protected:
+		//! Reads all pending events into the state, listeners are no longer called once one returns false
+		void _processEvents();
+
+		/**
+		@remarks
+			Applies the events of mFrame (one SYN_REPORT worth) to the state, then notifies
+			the listener of buttons and POVs. Axes are only flagged in mMovedAxes
+		@param notify
+			False to only update the state, after a listener asked to stop
+		@returns
+			False if a listener asked to stop (or notify was false)
+		*/
+		bool _applyFrame(bool notify);
+
+		//! Fills mFrame with the device state that differs from ours, after the kernel dropped events
+		void _resync(const input_event& report);
+
 		int mJoyStick;
+		LinuxEventReader mReader;
 		LinuxForceFeedback* ff_effect;
-		std::map<int, int> mButtonMap;
-		std::map<int, int> mAxisMap;
-		std::map<int, Range> mRanges;
+
+		//! Events of the frame being read, applied at its SYN_REPORT
+		std::vector<input_event> mFrame;
+
+		//! True after a SYN_DROPPED, until the next SYN_REPORT
+		bool mDropping;
+
+		//! Kernel time of the latest event of each axis in mMovedAxes
+		std::vector<std::uint64_t> mAxisTime;
+
+		//! Linux button/axis code to OIS button/axis, -1 if unmapped
+		short mButtonMap[KEY_MAX + 1];
+		short mAxisMap[ABS_MAX + 1];
+
+		//! Per OIS axis: device range, and the Q16 factors mapping it onto MIN_AXIS..MAX_AXIS (abs = (value * scale + bias) >> 16)
+		Range mRanges[ABS_MAX + 1];
+		std::int64_t mAxisScale[ABS_MAX + 1];
+		std::int64_t mAxisBias[ABS_MAX + 1];
 	};
 }
 #endif //_LINUX_JOYSTICK_H_EADER_
@@ -30,7 +30,7 @@ following restrictions:
 #include "OISKeyboard.h"
 #include <X11/Xlib.h>
 #include <X11/XKBlib.h>
-#include <unordered_map>
+#include <vector>
 
 namespace OIS
 {
@@ -48,11 +48,14 @@ namespace OIS
 		virtual const std::string& getAsString(KeyCode kc);
 
 		/** @copydoc Keyboard::getAsKeyCode */
-		virtual OIS::KeyCode getAsKeyCode(std::string str);
+		virtual OIS::KeyCode getAsKeyCode(const std::string& str);
 
 		/** @copydoc Keyboard::copyKeyStates */
 		virtual void copyKeyStates(char keys[256]) const;
 
+		/** @copydoc Keyboard::getKeyStates */
+		virtual const KeyMask& getKeyStates() const { return mKeyStates; }
+
 		/** @copydoc Object::setBuffered */
 		virtual void setBuffered(bool buffered);
 
@@ -65,75 +68,88 @@ namespace OIS
 		/** @copydoc Object::_initialize */
 		virtual void _initialize();
 
+		//! Internal method, called by the manager's event pump with an event for this keyboard
+		void _pushXEvent(const XEvent& event) { mXEvents.push_back(event); }
+
+		//! Internal method, true while pumped events wait for the next capture
+		bool _hasXEvents() const { return !mXEvents.empty(); }
+
 	protected:
-		inline bool _isKeyRepeat(XEvent& event)
+		inline bool _isKeyRepeat(std::size_t release) const
 		{
 			//When a key is repeated, there will be two events: released, followed by another immediate pressed. So check to see if another pressed is present
-			if(!XPending(display))
+			if(release + 1 >= mXEvents.size())
 				return false;
 
-			XEvent e;
-			XPeekEvent(display, &e);
-			if(e.type == KeyPress && e.xkey.keycode == event.xkey.keycode && (e.xkey.time - event.xkey.time) < 2)
-			{
-				XNextEvent(display, &e);
-				XFilterEvent(&event, None);
-				return true;
-			}
-
-			return false;
+			const XEvent& e = mXEvents[release + 1];
+			return e.type == KeyPress && e.xkey.keycode == mXEvents[release].xkey.keycode && (e.xkey.time - mXEvents[release].xkey.time) < 2;
 		}
 
-		bool _injectKeyDown(KeyCode kc, int text);
-		bool _injectKeyUp(KeyCode kc);
+		bool _injectKeyDown(KeyCode kc, int text, std::uint64_t time);
+		bool _injectKeyUp(KeyCode kc, std::uint64_t time);
 		void _handleKeyPress(XEvent& event);
 		void _handleKeyRelease(XEvent& event);
 
-		inline KeyCode KeySymToOISKeyCode(KeySym keySym)
+		inline KeyCode KeySymToOISKeyCode(KeySym keySym) const
 		{
-			if(keySym != NoSymbol)
-			{
-				//Check for explicit convert
-				const auto result = keyConversionToOIS.find(keySym);
-				if(result != keyConversionToOIS.end())
-					return result->second;
-
-				::KeyCode xkc = XKeysymToKeycode(display, keySym);
-				if(xkc > 8)
-					return static_cast<KeyCode>(xkc - 8);
-			}
-			return KC_UNASSIGNED;
+			//Latin-1 and the function key page cover nearly every key, one load each
+			if(keySym < 0x100)
+				return mLatinKeyCodes[keySym];
+			if((keySym & ~0xFFul) == 0xFF00)
+				return mFunctionKeyCodes[keySym & 0xFF];
+			return keySym == NoSymbol ? KC_UNASSIGNED : _findKeySym(keySym);
 		}
 
-		inline KeySym OISKeyCodeToKeySym(KeyCode kc)
+		inline KeySym OISKeyCodeToKeySym(KeyCode kc) const
 		{
-			if(kc == KC_UNASSIGNED)
-				return NoSymbol;
+			return kc > 255 ? NoSymbol : mKeySyms[kc];
+		}
 
-			//Check for explicit convert
-			const auto result = keyConversionFromOIS.find(kc);
-			if(result != keyConversionFromOIS.end())
-				return result->second;
+		//! Binary search of the keymap symbols outside of the Latin-1 and function key pages
+		KeyCode _findKeySym(KeySym keySym) const;
 
-			::KeyCode xkc = kc + 8;
-			return XkbKeycodeToKeysym(display, xkc, 0, 0);
-		}
+		/**
+		@remarks
+			Rebuilds the KeySym <-> KeyCode caches, key names and lock masks from the current keymap
+			of the display.
+			Called from _initialize and whenever the server sends a MappingNotify
+		*/
+		void _refreshKeyMap();
 
-		//! Explict convertion for non-text symbols
-		typedef std::unordered_map<KeySym, KeyCode> XtoOIS_KeyMap;
-		XtoOIS_KeyMap keyConversionToOIS;
+		//! Fills mKeyNames and mKeyCodesByName from the KeySym caches
+		void _internKeyNames();
+		void _addKeyName(KeySym keySym, KeyCode kc);
 
-		typedef std::unordered_map<KeyCode, KeySym, std::hash<int>> OIStoX_KeyMap;
-		OIStoX_KeyMap keyConversionFromOIS;
+		//! Resets the caches to the explicit conversions only (no X calls, no allocations)
+		void _seedKeyMap();
 
-		void addKeyConversion(KeySym x_key, KeyCode ois_key);
+		//! KeySym to KeyCode for the Latin-1 (0x0000-0x00FF) and function key (0xFF00-0xFFFF) pages
+		KeyCode mLatinKeyCodes[256];
+		KeyCode mFunctionKeyCodes[256];
 
-		//! Depressed Key List
-		char KeyBuffer[256];
+		//! Every other KeySym found in the keymap, sorted by KeySym
+		typedef std::vector<std::pair<KeySym, KeyCode>> KeySymList;
+		KeySymList mOtherKeyCodes;
+
+		//! KeyCode to KeySym (level 0 of the first group)
+		KeySym mKeySyms[256];
+
+		//! Text returned by the X lookup, UTF-8. Only grows
+		std::vector<char> mLookupBuffer;
+
+		//! Events the manager pumped for us since the last capture. Only grows
+		std::vector<XEvent> mXEvents;
+
+		//! Interned getAsString results, indexed by KeyCode
+		std::string mKeyNames[256];
+
+		//! Name of every KeySym in the keymap, sorted by name for getAsKeyCode
+		typedef std::vector<std::pair<std::string, KeyCode>> KeyNameList;
+		KeyNameList mKeyCodesByName;
 
 		//! X11 Stuff
 		Window window;
-		Display* display;
+		Display* display; //Shared with the mouse, owned by the manager
 		XIM xim;
 		XIMStyle ximStyle;
 		XIC xic;
@@ -142,8 +158,6 @@ namespace OIS
 
 		int capsLockMask;
 		int numLockMask;
-
-		std::string mGetString;
 	};
 }
 
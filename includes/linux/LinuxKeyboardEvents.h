@@ -0,0 +1,102 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef _LINUX_KEYBOARDEVENTS_H_EADER_
+#define _LINUX_KEYBOARDEVENTS_H_EADER_
+
+#include "linux/LinuxPrereqs.h"
+#include "linux/LinuxEventReader.h"
+#include "OISKeyboard.h"
+
+namespace OIS
+{
+	/**
+		Keyboard read straight from its evdev node, without X. Created instead of LinuxKeyboard
+		when the manager is created with linux_evdev_input, so it also works without a window
+		or display server. There is no keymap without X, text is translated with a fixed US layout.
+	*/
+	class LinuxEventKeyboard : public Keyboard
+	{
+	public:
+		LinuxEventKeyboard(InputManager* creator, bool buffered, bool grab, const EventDeviceInfo& info);
+		virtual ~LinuxEventKeyboard();
+
+		/** @copydoc Keyboard::isKeyDown */
+		virtual bool isKeyDown(KeyCode key) const { return mKeyStates.test(key); }
+
+		/** @copydoc Keyboard::getAsString */
+		virtual const std::string& getAsString(KeyCode kc);
+
+		/** @copydoc Keyboard::getAsKeyCode */
+		virtual KeyCode getAsKeyCode(const std::string& str);
+
+		/** @copydoc Keyboard::copyKeyStates */
+		virtual void copyKeyStates(char keys[256]) const;
+
+		/** @copydoc Keyboard::getKeyStates */
+		virtual const KeyMask& getKeyStates() const { return mKeyStates; }
+
+		/** @copydoc Object::setBuffered */
+		virtual void setBuffered(bool buffered);
+
+		/** @copydoc Object::capture */
+		virtual void capture();
+
+		/** @copydoc Object::queryInterface */
+		virtual Interface* queryInterface(Interface::IType) { return 0; }
+
+		/** @copydoc Object::_initialize */
+		virtual void _initialize();
+
+		//! For internal use only... Returns the device to the manager, to make it available again
+		const EventDeviceInfo& _getDeviceInfo() const { return mInfo; }
+
+		//! Converts an evdev KEY_* code into a KeyCode, KC_UNASSIGNED if there is no match
+		static KeyCode _toKeyCode(unsigned int code);
+
+	protected:
+		//! Reads all pending events into the state, listeners are no longer called once one returns false
+		void _processEvents();
+
+		//! Applies one key change and, if notify is set, returns the listener's result
+		bool _injectKey(unsigned int code, bool down, std::uint64_t time, bool notify);
+
+		//! Presses/releases whatever differs from the kernel's key state, after it dropped events
+		bool _resync(std::uint64_t time, bool notify);
+
+		//! US layout text of an evdev key with the current modifiers, 0 for none
+		unsigned int _translate(unsigned int code) const;
+
+		EventDeviceInfo mInfo;
+		LinuxEventReader mReader;
+
+		//! Take the device exclusively (EVIOCGRAB), so the console or X do not see our keys
+		bool mGrab;
+
+		//! True after a SYN_DROPPED, until the next SYN_REPORT
+		bool mDropping;
+	};
+}
+#endif //_LINUX_KEYBOARDEVENTS_H_EADER_
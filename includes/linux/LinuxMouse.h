@@ -29,13 +29,14 @@ following restrictions:
 #include "linux/LinuxPrereqs.h"
 #include "OISMouse.h"
 #include <X11/Xlib.h>
+#include <vector>
 
 namespace OIS
 {
 	class LinuxMouse : public Mouse
 	{
 	public:
-		LinuxMouse(InputManager* creator, bool buffered, bool grab, bool hide);
+		LinuxMouse(InputManager* creator, bool buffered, bool grab, bool hide, bool raw = true);
 		virtual ~LinuxMouse();
 
 		/** @copydoc Object::setBuffered */
@@ -43,8 +44,9 @@ namespace OIS
 
 		/**
 		@remarks
-			Note: Calling this will also update the keyboard (X11 updates in a single
-			event queue). Updates State and/or raises event for buffered mode..
+			Note: The keyboard shares this X connection, calling this also reads its events,
+			which are kept until the keyboard is captured. Updates State and/or raises event
+			for buffered mode..
 		*/
 		virtual void capture();
 
@@ -57,16 +59,109 @@ namespace OIS
 		void grab(bool grab);
 		void hide(bool hide);
 
+		/** @remarks True when grabbed motion comes from XInput2 raw events instead of warping */
+		bool isRawMotion() const { return mRawMotion; }
+
+		//! Internal method, called by the manager's event pump with an event for this mouse
+		void _pushXEvent(XEvent& event);
+
+		//! Internal method, true while pumped events wait for the next capture
+		bool _hasXEvents() const { return !mXEvents.empty(); }
+
 	protected:
 		void _processXEvents();
 
+		//! Applies one pumped event, false when a listener asked to stop
+		bool _processXEvent(XEvent& event, std::size_t& rawIndex);
+
+		//! Selects XI_RawMotion and XI_DeviceChanged on the root window, false when XInput2 is unavailable
+		bool _selectRawMotion();
+
+		//! Deltas of one XI_RawMotion event, the wheels in 120 per notch
+		struct RawMotion
+		{
+			double dx, dy, dz, dh;
+			Time time;
+		};
+
+		//! An XInput 2.1 scroll valuator of a physical device
+		struct ScrollValuator
+		{
+			int source;
+			int number;
+			bool horizontal;
+			double increment;
+		};
+
+		//! Which wheels of a physical device are scroll valuators, its valuators are in mScrollValuators
+		struct ScrollSource
+		{
+			int source;
+			bool vertical, horizontal;
+		};
+
+		//! The scroll axes of the device, asked from the server the first time it is seen
+		ScrollSource _getScrollSource(int source);
+
+		//! Drops what is known about the device's valuators, they are asked for again on its next use
+		void _forgetScrollSource(int source);
+
+		//! The scroll valuator with that number of the device, 0 if it is no scroll valuator
+		const ScrollValuator* _findScrollValuator(int source, int number) const;
+
+		/**
+		@remarks
+			Decodes an XI_RawMotion cookie into mRawMotions, and applies XI_DeviceChanged to the
+			scroll valuators. Cookie data only lives until the next XNextEvent, so this happens
+			in the pump rather than in capture
+		@returns
+			False for any other generic event (including XI_DeviceChanged)
+		*/
+		bool _fetchRawMotion(XEvent& event);
+
+		//! Applies one decoded XI_RawMotion
+		void _processRawMotion(const RawMotion& motion);
+
+		//! Adds relative motion to the state and event queue, clamping abs to the window while grabbed
+		void _addMotion(int dx, int dy, std::uint64_t time);
+
+		//! Adds wheel motion (120 per notch) to the state and event queue
+		void _addScroll(int dz, int dh, std::uint64_t time);
+
 		bool mMoved, mWarped;
 
+		//! Raw motion was requested / is active, and the XInput extension opcode
+		bool useRawMotion;
+		bool mRawMotion;
+		int mXIOpcode;
+
+		//! Sub pixel (and sub step of the wheels) remainder of the raw deltas, carried over to the next event
+		double mRawRemainderX, mRawRemainderY, mRawRemainderZ, mRawRemainderH;
+
+		//! The device driving the pointer. Its raw events carry smooth scrolling for the wheels
+		//! it has valuators for, the emulated wheel buttons of those are ignored while grabbed
+		ScrollSource mScrollSource;
+
+		//! Master pointer the raw events come from, its slave switches change mScrollSource
+		int mPointerId;
+
+		//! Scroll valuators of every device seen so far, and the devices already queried
+		std::vector<ScrollValuator> mScrollValuators;
+		std::vector<ScrollSource> mScrollSources;
+
+		//! Events the manager pumped for us since the last capture, and the raw motions
+		//! their GenericEvents stand for (in the same order). Both only grow
+		std::vector<XEvent> mXEvents;
+		std::vector<RawMotion> mRawMotions;
+
+		//! Time of the latest motion folded into this frame's mouseMoved
+		std::uint64_t mMoveTime;
+
 		//Since X11 provides us with absolute values, we need to keep track of relative values
 		long oldXMouseX, oldXMouseY, oldXMouseZ;
 
 		Window window;	  //The X Window
-		Display* display; //The X display
+		Display* display; //The X display, shared with the keyboard and owned by the manager
 		Cursor cursor;	  //A blank cursor
 
 		bool grabMouse;		 //Are we grabbing the mouse to the window?
@@ -0,0 +1,95 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+#ifndef _LINUX_MOUSEEVENTS_H_EADER_
+#define _LINUX_MOUSEEVENTS_H_EADER_
+
+#include "linux/LinuxPrereqs.h"
+#include "linux/LinuxEventReader.h"
+#include "OISMouse.h"
+
+namespace OIS
+{
+	/**
+		Mouse read straight from its evdev node, without X. Created instead of LinuxMouse when
+		the manager is created with linux_evdev_input. Motion is the device's own unaccelerated
+		counts, the absolute position is only clamped to the MouseState's width and height.
+		Wheels with high resolution reports move Z and H in fractions of a notch.
+	*/
+	class LinuxEventMouse : public Mouse
+	{
+	public:
+		LinuxEventMouse(InputManager* creator, bool buffered, bool grab, const EventDeviceInfo& info);
+		virtual ~LinuxEventMouse();
+
+		/** @copydoc Object::setBuffered */
+		virtual void setBuffered(bool buffered);
+
+		/** @copydoc Object::capture */
+		virtual void capture();
+
+		/** @copydoc Object::queryInterface */
+		virtual Interface* queryInterface(Interface::IType) { return 0; }
+
+		/** @copydoc Object::_initialize */
+		virtual void _initialize();
+
+		//! For internal use only... Returns the device to the manager, to make it available again
+		const EventDeviceInfo& _getDeviceInfo() const { return mInfo; }
+
+	protected:
+		//! Reads all pending events into the state, returns false once a listener asked to stop
+		bool _processEvents();
+
+		//! Applies one button change and, if notify is set, returns the listener's result
+		bool _injectButton(MouseButtonID id, bool down, std::uint64_t time, bool notify);
+
+		//! Presses/releases whatever differs from the kernel's button state, after it dropped events
+		bool _resync(std::uint64_t time, bool notify);
+
+		//! Moves one axis (0 X, 1 Y, 2 Z, 3 H) by a relative amount
+		void _addMotion(int axis, int delta, std::uint64_t time);
+
+		EventDeviceInfo mInfo;
+		LinuxEventReader mReader;
+
+		//! Take the device exclusively (EVIOCGRAB), so X does not move its pointer too
+		bool mGrab;
+
+		//! True after a SYN_DROPPED, until the next SYN_REPORT
+		bool mDropping;
+
+		//! Motion happened this capture, and the time of the latest motion
+		bool mMoved;
+		std::uint64_t mMoveTime;
+
+		//! Motion of the report being read, recorded in the motion history at SYN_REPORT
+		int mFrameX, mFrameY;
+
+		//! The device has REL_WHEEL_HI_RES/REL_HWHEEL_HI_RES, the notch codes are then ignored
+		bool mHiResWheel, mHiResHWheel;
+	};
+}
+#endif //_LINUX_MOUSEEVENTS_H_EADER_
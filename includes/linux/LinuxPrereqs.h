@@ -32,33 +32,47 @@ following restrictions:
 #endif
 
 #include "OISPrereqs.h"
+#include <linux/input.h>
 
 //! Max number of elements to collect from buffered input
 #define JOY_BUFFERSIZE 64
 
+//! Max number of ready devices to collect from a single epoll_wait
+#define EPOLL_BUFFERSIZE 32
+
+//! Number of events each evdev device can queue up between captures in threaded mode
+#define EVENT_RINGSIZE 1024
+
 namespace OIS
 {
 	class LinuxInputManager;
 	class LinuxKeyboard;
 	class LinuxJoyStick;
 	class LinuxMouse;
+	class LinuxEventKeyboard;
+	class LinuxEventMouse;
 
 	class LinuxForceFeedback;
+	class LinuxEventReader;
 
 	class Range
 	{
 	public:
-		Range() {};
-		Range(int _min, int _max) :
-		 min(_min), max(_max) {};
+		Range() :
+		 min(0), max(0), flat(0), fuzz(0) {};
+		Range(int _min, int _max, int _flat = 0, int _fuzz = 0) :
+		 min(_min), max(_max), flat(_flat), fuzz(_fuzz) {};
 		int min, max;
+		//! Dead zone and noise filter reported by the driver (input_absinfo)
+		int flat, fuzz;
 	};
 
 	class JoyStickInfo
 	{
 	public:
 		JoyStickInfo() :
-		 devId(-1), joyFileD(-1), version(0), axes(0), buttons(0), hats(0) { }
+		 devId(-1), joyFileD(-1), version(0), axes(0), buttons(0), hats(0),
+		 button_map(KEY_MAX + 1, -1), axis_map(ABS_MAX + 1, -1), axis_range(ABS_MAX + 1) { }
 		//! Device number (/dev/input/j#) or /dev/input/event#
 		int devId;
 		//! File descriptor
@@ -73,15 +87,33 @@ namespace OIS
 		unsigned char buttons;
 		//! Number of hats
 		unsigned char hats;
-		//! Maps Linux button values to OIS buttons values
-		std::map<int, int> button_map;
-		//! Maps Linux axis values to OIS axis
-		std::map<int, int> axis_map;
-		//! Maps OIS axis values to it's range
-		std::map<int, Range> axis_range;
+		//! Maps Linux button values (index) to OIS buttons values, -1 if not a button
+		std::vector<short> button_map;
+		//! Maps Linux axis values (index) to OIS axis, -1 if not an axis
+		std::vector<short> axis_map;
+		//! Maps OIS axis values (index) to it's range
+		std::vector<Range> axis_range;
 	};
 
 	typedef std::vector<JoyStickInfo> JoyStickInfoList;
+
+	//! An evdev keyboard or mouse, opened directly instead of through X (linux_evdev_input)
+	class EventDeviceInfo
+	{
+	public:
+		EventDeviceInfo() :
+		 devId(-1), fd(-1), combined(false) { }
+		//! Device number, in order of discovery per type
+		int devId;
+		//! File descriptor of the /dev/input/event# node
+		int fd;
+		//! Device name reported by the driver
+		std::string vendor;
+		//! The node is both a keyboard and a mouse, each object opens it separately and neither grabs it
+		bool combined;
+	};
+
+	typedef std::vector<EventDeviceInfo> EventDeviceInfoList;
 }
 
 #endif //_LINUX_INPUTSYSTEM_PREREQS_H
@@ -85,7 +85,7 @@ namespace OIS
 
 		unsigned int& _getModifiers() { return mModifiers; }
 
-		virtual OIS::KeyCode getAsKeyCode(std::string str)
+		virtual OIS::KeyCode getAsKeyCode(const std::string& str)
 		{
 			//TODO implement me
 			return (OIS::KeyCode)(0);
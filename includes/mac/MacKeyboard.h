@@ -57,7 +57,7 @@ namespace OIS
 
 		// Returns a description of the given key
 		virtual std::string& getAsString(KeyCode key);
-		virtual KeyCode getAsKeyCode(std::string str)
+		virtual KeyCode getAsKeyCode(const std::string& str)
 		{ /*TODO: Implement OS version*/
 			return KC_UNASSIGNED;
 		}
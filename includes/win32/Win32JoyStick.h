@@ -46,6 +46,9 @@ namespace OIS
 		//! hanlde xinput
 		void captureXInput();
 
+		//! handle directinput based devices
+		void _captureDirectInput();
+
 		/** @copydoc Object::queryInterface */
 		virtual Interface* queryInterface(Interface::IType type);
 
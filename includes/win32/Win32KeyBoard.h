@@ -54,7 +54,7 @@ namespace OIS
 		virtual const std::string& getAsString(KeyCode kc);
 
 		/** @copydoc Keyboard::getAsKeyCode */
-		virtual KeyCode getAsKeyCode(std::string str)
+		virtual KeyCode getAsKeyCode(const std::string& str)
 		{ /*TODO: Implement OS version*/
 			return KC_UNASSIGNED;
 		}
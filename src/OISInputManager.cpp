@@ -27,8 +27,12 @@ following restrictions:
 #include "OISException.h"
 #include "OISFactoryCreator.h"
 #include "OISObject.h"
+#include "OISRingBuffer.h"
+#include "OISReplay.h"
 #include <sstream>
 #include <algorithm>
+#include <chrono>
+#include <thread>
 
 //Bring in correct Header / InputManager for current build platform
 #if defined OIS_SDL_PLATFORM
@@ -56,12 +60,17 @@ following restrictions:
 
 using namespace OIS;
 
+const int InputManager::PollInterval;
+
 //----------------------------------------------------------------------------//
 InputManager::InputManager(const std::string& name) :
  m_VersionName(OIS_VERSION_NAME),
  mInputSystemName(name),
  m_lircSupport(nullptr),
- m_wiiMoteSupport(nullptr)
+ m_wiiMoteSupport(nullptr),
+ mEventLog(nullptr),
+ mEventLogOverruns(0),
+ mRecorder(nullptr)
 {
 	mFactories.clear();
 	mFactoryObjects.clear();
@@ -77,6 +86,9 @@ InputManager::~InputManager()
 #if defined OIS_WIN32_WIIMOTE_SUPPORT
 	delete m_wiiMoteSupport;
 #endif
+
+	delete mEventLog;
+	delete mRecorder;
 }
 
 //----------------------------------------------------------------------------//
@@ -246,6 +258,82 @@ void InputManager::destroyInputObject(Object* obj)
 	}
 }
 
+//----------------------------------------------------------------------------//
+void InputManager::captureAll()
+{
+	for(FactoryCreatedObject::iterator i = mFactoryObjects.begin(); i != mFactoryObjects.end(); ++i)
+		i->first->capture();
+}
+
+//----------------------------------------------------------------------------//
+bool InputManager::waitForInput(int timeoutMs)
+{
+	//No way to wait on the devices here, sleep like a polling loop would instead of spinning
+	std::this_thread::sleep_for(std::chrono::milliseconds(timeoutMs < 0 ? PollInterval : timeoutMs));
+
+	captureAll();
+	return true;
+}
+
+//----------------------------------------------------------------------------//
+void InputManager::enableEventLog(unsigned int numEvents)
+{
+	delete mEventLog;
+	mEventLog = nullptr;
+	mEventLogOverruns.store(0, std::memory_order_relaxed);
+
+	if(numEvents > 0)
+		mEventLog = new RingBuffer<RawEvent>(numEvents);
+}
+
+//----------------------------------------------------------------------------//
+unsigned int InputManager::readEventLog(RawEvent* events, unsigned int maxEvents)
+{
+	if(mEventLog == nullptr)
+		return 0;
+
+	unsigned int count = std::min(maxEvents, mEventLog->readAvailable());
+	mEventLog->read(events, count);
+	return count;
+}
+
+//----------------------------------------------------------------------------//
+void InputManager::_logEvent(const Object* device, const InputEvent& evt)
+{
+	RawEvent raw;
+	raw.timestamp  = evt.timestamp;
+	raw.value	   = evt.value;
+	raw.code	   = evt.code;
+	raw.type	   = evt.type;
+	raw.device	   = (std::uint16_t)device->getID();
+	raw.deviceType = (std::uint16_t)device->type();
+
+	if(mEventLog)
+	{
+		if(mEventLog->writeAvailable() > 0)
+			mEventLog->write(&raw, 1);
+		else
+			mEventLogOverruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if(mRecorder)
+		mRecorder->append(raw);
+}
+
+//----------------------------------------------------------------------------//
+void InputManager::startRecording(const std::string& fileName)
+{
+	stopRecording();
+	mRecorder = new EventRecorder(fileName);
+}
+
+//----------------------------------------------------------------------------//
+void InputManager::stopRecording()
+{
+	delete mRecorder;
+	mRecorder = nullptr;
+}
+
 //----------------------------------------------------------------------------//
 void InputManager::addFactoryCreator(FactoryCreator* factory)
 {
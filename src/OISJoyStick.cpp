@@ -24,6 +24,8 @@ following restrictions:
     3. This notice may not be removed or altered from any source distribution.
 */
 #include "OISJoyStick.h"
+#include "OISException.h"
+#include <cmath>
 
 using namespace OIS;
 
@@ -33,7 +35,9 @@ JoyStick::JoyStick(const std::string& vendor, bool buffered, int devID, InputMan
  mSliders(0),
  mPOVs(0),
  mListener(nullptr),
- mVector3Sensitivity(OIS_JOYSTICK_VECTOR3_DEFAULT)
+ mVector3Sensitivity(OIS_JOYSTICK_VECTOR3_DEFAULT),
+ mAxisSensitivity(OIS_JOYSTICK_AXIS_DEFAULT),
+ mDroppedFrames(0)
 {
 }
 
@@ -63,6 +67,18 @@ float JoyStick::getVector3Sensitivity() const
 	return mVector3Sensitivity;
 }
 
+//----------------------------------------------------------------------------//
+void JoyStick::setAxisSensitivity(int units)
+{
+	mAxisSensitivity = std::max(0, units);
+}
+
+//----------------------------------------------------------------------------//
+int JoyStick::getAxisSensitivity() const
+{
+	return mAxisSensitivity;
+}
+
 //----------------------------------------------------------------------------//
 void JoyStick::setEventCallback(JoyStickListener* joyListener)
 {
@@ -74,3 +90,128 @@ JoyStickListener* JoyStick::getEventCallback() const
 {
 	return mListener;
 }
+
+//----------------------------------------------------------------------------//
+JoyStick::AxisCalibration& JoyStick::_getCalibration(int axis)
+{
+	if(axis < 0 || axis >= (int)mState.mAxes.size())
+		OIS_EXCEPT(E_InvalidParam, "JoyStick >> No such axis");
+
+	//Start new entries from the current values, so changing the calibration applies right away
+	for(std::size_t i = mCalibration.size(); i < mState.mAxes.size(); ++i)
+	{
+		mCalibration.push_back(AxisCalibration());
+		mCalibration.back().raw = mState.mAxes[i].abs;
+	}
+
+	return mCalibration[axis];
+}
+
+//----------------------------------------------------------------------------//
+void JoyStick::setAxisDeadZone(int axis, int deadZone)
+{
+	AxisCalibration& cal = _getCalibration(axis);
+
+	cal.deadZone	  = std::max(0, std::min(deadZone, MAX_AXIS - 1));
+	//Rounded up, so full deflection stays reachable
+	cal.deadZoneScale = (((std::int64_t)(MAX_AXIS + 1) << 16) + MAX_AXIS - cal.deadZone) / (MAX_AXIS + 1 - cal.deadZone);
+	mState.mAxes[axis].abs = _calibrate(cal, cal.raw);
+}
+
+//----------------------------------------------------------------------------//
+int JoyStick::getAxisDeadZone(int axis) const
+{
+	return (axis >= 0 && axis < (int)mCalibration.size()) ? mCalibration[axis].deadZone : 0;
+}
+
+//----------------------------------------------------------------------------//
+void JoyStick::setAxisRadialDeadZone(int axisX, int axisY, int deadZone)
+{
+	AxisCalibration& x = _getCalibration(axisX);
+	AxisCalibration& y = _getCalibration(axisY);
+
+	//Unpair from previous partners
+	if(x.radialPartner >= 0)
+		mCalibration[x.radialPartner].radialPartner = -1;
+	if(y.radialPartner >= 0)
+		mCalibration[y.radialPartner].radialPartner = -1;
+
+	if(deadZone > 0 && axisX != axisY)
+	{
+		x.radialPartner	 = axisY;
+		y.radialPartner	 = axisX;
+		x.radialDeadZone = y.radialDeadZone = std::min(deadZone, MAX_AXIS - 1);
+		_applyRadialDeadZone(axisX, axisY);
+	}
+	else
+	{
+		x.radialPartner = y.radialPartner = -1;
+		x.radialDeadZone = y.radialDeadZone = 0;
+	}
+}
+
+//----------------------------------------------------------------------------//
+void JoyStick::setAxisResponseCurve(int axis, const std::vector<int>& points)
+{
+	AxisCalibration& cal = _getCalibration(axis);
+
+	if(points.size() < 2)
+	{
+		cal.curve.clear();
+	}
+	else
+	{
+		//Resample the points into the lookup table, linearly interpolating between them
+		cal.curve.resize(OIS_JOYSTICK_CURVE_SEGMENTS + 2);
+		for(int i = 0; i <= OIS_JOYSTICK_CURVE_SEGMENTS; ++i)
+		{
+			float pos	 = (float)i * (points.size() - 1) / OIS_JOYSTICK_CURVE_SEGMENTS;
+			std::size_t p = std::min((std::size_t)pos, points.size() - 2);
+			float frac	 = pos - (float)p;
+			float value	 = points[p] + (points[p + 1] - points[p]) * frac;
+
+			//Stored as Q15 fraction of full deflection
+			cal.curve[i] = (std::int32_t)(std::max(0.0f, std::min(1.0f, value / MAX_AXIS)) * 32768.0f + 0.5f);
+		}
+		cal.curve[OIS_JOYSTICK_CURVE_SEGMENTS + 1] = cal.curve[OIS_JOYSTICK_CURVE_SEGMENTS];
+	}
+
+	mState.mAxes[axis].abs = _calibrate(cal, cal.raw);
+}
+
+//----------------------------------------------------------------------------//
+void JoyStick::setAxisResponseExponent(int axis, float exponent)
+{
+	std::vector<int> points;
+	if(exponent != 1.0f)
+	{
+		points.resize(OIS_JOYSTICK_CURVE_SEGMENTS + 1);
+		for(int i = 0; i <= OIS_JOYSTICK_CURVE_SEGMENTS; ++i)
+			points[i] = (int)(std::pow((float)i / OIS_JOYSTICK_CURVE_SEGMENTS, exponent) * MAX_AXIS + 0.5f);
+	}
+
+	setAxisResponseCurve(axis, points);
+}
+
+//----------------------------------------------------------------------------//
+void JoyStick::_applyRadialDeadZone(int axisX, int axisY)
+{
+	AxisCalibration& x = mCalibration[axisX];
+	AxisCalibration& y = mCalibration[axisY];
+
+	float fx	   = (float)x.raw;
+	float fy	   = (float)y.raw;
+	float mag	   = std::sqrt(fx * fx + fy * fy);
+	float deadZone = (float)x.radialDeadZone;
+
+	//Rescale the magnitude left outside the dead zone to the full range, keeping the direction
+	float scale = 0.0f;
+	if(mag > deadZone)
+		scale = (mag - deadZone) / (MAX_AXIS - deadZone) * MAX_AXIS / mag;
+
+	std::int32_t rx = (std::int32_t)std::max((float)MIN_AXIS, std::min((float)MAX_AXIS, fx * scale));
+	std::int32_t ry = (std::int32_t)std::max((float)MIN_AXIS, std::min((float)MAX_AXIS, fy * scale));
+
+	mState.mAxes[axisX].abs = _calibrate(x, rx);
+	mState.mAxes[axisY].abs = _calibrate(y, ry);
+}
@@ -52,3 +52,193 @@ unsigned int Keyboard::getModifiers() const
 {
 	return mModifiers;
 }
+
+//----------------------------------------------------------------------//
+const KeyMask& Keyboard::getKeyStates() const
+{
+	//Generic version for backends which only implement isKeyDown
+	for(int kc = 0; kc < 256; ++kc)
+		mKeyStates.set(kc, isKeyDown((KeyCode)kc));
+
+	return mKeyStates;
+}
+
+//----------------------------------------------------------------------//
+bool Keyboard::isAnyKeyDown(const KeyMask& keys) const
+{
+	return (getKeyStates() & keys).any();
+}
+
+//----------------------------------------------------------------------//
+bool Keyboard::areAllKeysDown(const KeyMask& keys) const
+{
+	return (getKeyStates() & keys) == keys;
+}
+
+namespace
+{
+	//Length of the UTF-8 sequence each lead byte starts, 0 for bytes which cannot start one
+	const unsigned char UTF8SequenceLength[256] = {
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //00
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //10
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //20
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //30
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //40
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //50
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //60
+		1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, //70
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //80
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //90
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //A0
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, //B0
+		0, 0, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, //C0
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, //D0
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, //E0
+		4, 4, 4, 4, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0	//F0
+	};
+
+	const std::uint32_t ReplacementCharacter = 0xFFFD;
+
+	//US key caps of KC_ESCAPE..KC_SPACE, which share their values with the PC scan codes
+	const char USKeyCaps[] = "\0\x1b" "1234567890-=" "\b\t" "QWERTYUIOP[]" "\r\0" "ASDFGHJKL;'`" "\0\\" "ZXCVBNM,./" "\0*\0 ";
+	static_assert(sizeof(USKeyCaps) == KC_SPACE + 2, "Key caps must cover KC_UNASSIGNED..KC_SPACE");
+
+	//Names of every KeyCode, built once: the US key cap where there is one, else Key_<n>
+	const std::string* defaultKeyNames()
+	{
+		static const struct Names
+		{
+			std::string name[256];
+			Names()
+			{
+				for(unsigned int kc = 0; kc < 256; ++kc)
+					name[kc] = "Key_" + std::to_string(kc);
+
+				for(unsigned int kc = KC_1; kc < KC_SPACE; ++kc)
+					if(USKeyCaps[kc] > ' ')
+						name[kc] = std::string(1, USKeyCaps[kc]);
+
+				name[KC_SPACE] = "Space";
+			}
+		} names;
+		return names.name;
+	}
+}
+
+//----------------------------------------------------------------------//
+const std::string& Keyboard::_getDefaultKeyName(KeyCode kc)
+{
+	return defaultKeyNames()[kc > 255 ? KC_UNASSIGNED : kc];
+}
+
+//----------------------------------------------------------------------//
+KeyCode Keyboard::_getDefaultKeyCode(const std::string& name)
+{
+	const std::string* names = defaultKeyNames();
+	for(unsigned int kc = 1; kc < 256; ++kc)
+		if(names[kc] == name)
+			return (KeyCode)kc;
+
+	return KC_UNASSIGNED;
+}
+
+//----------------------------------------------------------------------//
+std::size_t Keyboard::decodeUTF8(const char* utf8, std::size_t length, std::uint32_t* utf32, std::size_t maxChars)
+{
+	const unsigned char* in	 = reinterpret_cast<const unsigned char*>(utf8);
+	const unsigned char* end = in + length;
+	std::size_t count		 = 0;
+
+	while(in < end && count < maxChars)
+	{
+		//ASCII fast path
+		if(*in < 0x80)
+		{
+			utf32[count++] = *in++;
+			continue;
+		}
+
+		const unsigned char lead = *in;
+		const unsigned int len	 = UTF8SequenceLength[lead];
+		if(len == 0)
+		{
+			utf32[count++] = ReplacementCharacter;
+			++in;
+			continue;
+		}
+
+		//The second byte range excludes overlongs (E0, F0), surrogates (ED) and values past U+10FFFF (F4)
+		unsigned char lower = lead == 0xE0 ? 0xA0 : (lead == 0xF0 ? 0x90 : 0x80);
+		unsigned char upper = lead == 0xED ? 0x9F : (lead == 0xF4 ? 0x8F : 0xBF);
+
+		std::uint32_t codePoint = lead & (0x7F >> len);
+		unsigned int i			= 1;
+		for(; i < len && in + i < end; ++i)
+		{
+			if(in[i] < lower || in[i] > upper)
+				break;
+
+			codePoint = (codePoint << 6) | (in[i] & 0x3F);
+			lower	  = 0x80;
+			upper	  = 0xBF;
+		}
+
+		//A broken sequence is replaced once, and decoding resumes at the offending byte
+		utf32[count++] = i == len ? codePoint : ReplacementCharacter;
+		in += i;
+	}
+
+	return count;
+}
+
+//----------------------------------------------------------------------//
+std::size_t Keyboard::encodeUTF8(std::uint32_t codePoint, char* utf8)
+{
+	if((codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+		codePoint = ReplacementCharacter;
+
+	if(codePoint < 0x80)
+	{
+		utf8[0] = (char)codePoint;
+		return 1;
+	}
+	if(codePoint < 0x800)
+	{
+		utf8[0] = (char)(0xC0 | (codePoint >> 6));
+		utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+		return 2;
+	}
+	if(codePoint < 0x10000)
+	{
+		utf8[0] = (char)(0xE0 | (codePoint >> 12));
+		utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+		utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+		return 3;
+	}
+
+	utf8[0] = (char)(0xF0 | (codePoint >> 18));
+	utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+	utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+	utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+	return 4;
+}
+
+//----------------------------------------------------------------------//
+bool Keyboard::_injectText(const char* utf8, std::size_t length, std::uint64_t time, bool notify)
+{
+	if(mTextMode == Off || length == 0)
+		return notify;
+
+	//Never more code points than bytes
+	if(mTextUTF32.size() < length)
+		mTextUTF32.resize(length);
+
+	const std::size_t count = decodeUTF8(utf8, length, &mTextUTF32[0], length);
+	for(std::size_t i = 0; i < count; ++i)
+		_queueEvent(InputEvent::TextEntered, 0, (int)mTextUTF32[i], time);
+
+	if(notify && mBuffered && mListener)
+		return mListener->textEntered(TextEvent(this, utf8, length, &mTextUTF32[0], count, time));
+
+	return notify;
+}
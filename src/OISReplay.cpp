@@ -0,0 +1,427 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#include "OISReplay.h"
+#include "OISException.h"
+#include "OISInputManager.h"
+#include "OISVirtual.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#if !defined OIS_WIN32_PLATFORM
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace OIS;
+
+namespace
+{
+	//Queues the due events of one device from the recording on the virtual device
+	template <typename T>
+	void replayEvents(ReplayFactoryCreator* replay, ReplayFactoryCreator::ReplayDevice* device, T* obj)
+	{
+		std::uint64_t now	   = replay->_getReplayTime();
+		const RawEvent* events = replay->_getEvents();
+		std::uint64_t count	   = replay->getEventCount();
+
+		for(; device->cursor < count; ++device->cursor)
+		{
+			if(replay->_getPlayTime(device->cursor) > now)
+				break;
+
+			const RawEvent& evt = events[device->cursor];
+			if(evt.deviceType == device->type && evt.device == (std::uint16_t)device->id)
+			{
+				InputEvent e;
+				e.timestamp = evt.timestamp;
+				e.value		= evt.value;
+				e.code		= evt.code;
+				e.type		= evt.type;
+				obj->inject(e);
+			}
+		}
+	}
+
+	/** Keyboard fed from a recording */
+	class ReplayKeyboard : public VirtualKeyboard
+	{
+	public:
+		ReplayKeyboard(InputManager* creator, bool buffered, ReplayFactoryCreator* replay, ReplayFactoryCreator::ReplayDevice* device) :
+		 VirtualKeyboard(creator, buffered, device->id, "Replay"), mReplay(replay), mDevice(device) { }
+
+		void capture()
+		{
+			replayEvents(mReplay, mDevice, this);
+			VirtualKeyboard::capture();
+		}
+
+	protected:
+		ReplayFactoryCreator* mReplay;
+		ReplayFactoryCreator::ReplayDevice* mDevice;
+	};
+
+	/** Mouse fed from a recording */
+	class ReplayMouse : public VirtualMouse
+	{
+	public:
+		ReplayMouse(InputManager* creator, bool buffered, ReplayFactoryCreator* replay, ReplayFactoryCreator::ReplayDevice* device) :
+		 VirtualMouse(creator, buffered, device->id, "Replay"), mReplay(replay), mDevice(device) { }
+
+		void capture()
+		{
+			replayEvents(mReplay, mDevice, this);
+			VirtualMouse::capture();
+		}
+
+	protected:
+		ReplayFactoryCreator* mReplay;
+		ReplayFactoryCreator::ReplayDevice* mDevice;
+	};
+
+	/** JoyStick fed from a recording, with as many components as the recording used */
+	class ReplayJoyStick : public VirtualJoyStick
+	{
+	public:
+		ReplayJoyStick(InputManager* creator, bool buffered, ReplayFactoryCreator* replay, ReplayFactoryCreator::ReplayDevice* device) :
+		 VirtualJoyStick(creator, buffered, device->id, device->buttons, device->axes, device->povs, "Replay"), mReplay(replay), mDevice(device) { }
+
+		void capture()
+		{
+			replayEvents(mReplay, mDevice, this);
+			VirtualJoyStick::capture();
+		}
+
+	protected:
+		ReplayFactoryCreator* mReplay;
+		ReplayFactoryCreator::ReplayDevice* mDevice;
+	};
+}
+
+//---------------------------------------------------------------------------------//
+EventRecorder::EventRecorder(const std::string& fileName) :
+ mFd(-1), mHeader(0), mEvents(0), mCount(0), mCapacity(0)
+{
+#if defined OIS_WIN32_PLATFORM
+	OIS_UNUSED(fileName);
+	OIS_EXCEPT(E_NotSupported, "EventRecorder >> Recording is not supported on this platform");
+#else
+	mFd = open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if(mFd == -1)
+		OIS_EXCEPT(E_General, "EventRecorder >> Could not create recording file");
+
+	try
+	{
+		_grow();
+	}
+	catch(...)
+	{
+		close(mFd);
+		throw;
+	}
+#endif
+}
+
+//---------------------------------------------------------------------------------//
+EventRecorder::~EventRecorder()
+{
+#if !defined OIS_WIN32_PLATFORM
+	if(mHeader)
+		munmap(mHeader, sizeof(ReplayFileHeader) + mCapacity * sizeof(RawEvent));
+
+	//Cut off the unused part of the last chunk
+	if(mFd != -1)
+	{
+		if(ftruncate(mFd, sizeof(ReplayFileHeader) + mCount * sizeof(RawEvent)) != 0) { }
+		close(mFd);
+	}
+#endif
+}
+
+//---------------------------------------------------------------------------------//
+void EventRecorder::_grow()
+{
+#if !defined OIS_WIN32_PLATFORM
+	if(mHeader)
+		munmap(mHeader, sizeof(ReplayFileHeader) + mCapacity * sizeof(RawEvent));
+	mHeader = 0;
+	mEvents = 0;
+
+	std::uint64_t capacity = mCapacity + OIS_REPLAY_CHUNK;
+	std::size_t size	   = sizeof(ReplayFileHeader) + capacity * sizeof(RawEvent);
+	if(ftruncate(mFd, size) != 0)
+		OIS_EXCEPT(E_General, "EventRecorder >> Could not grow recording file");
+
+	void* map = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, mFd, 0);
+	if(map == MAP_FAILED)
+		OIS_EXCEPT(E_General, "EventRecorder >> Could not map recording file");
+
+	mCapacity = capacity;
+	mHeader	  = static_cast<ReplayFileHeader*>(map);
+	mEvents	  = reinterpret_cast<RawEvent*>(mHeader + 1);
+
+	memcpy(mHeader->magic, "OISR", 4);
+	mHeader->version = OIS_REPLAY_VERSION;
+	mHeader->count	 = mCount;
+#endif
+}
+
+//---------------------------------------------------------------------------------//
+ReplayFactoryCreator::ReplayFactoryCreator(const std::string& fileName, float speed) :
+ mFd(-1),
+ mMapSize(0),
+ mMap(0),
+ mEvents(0),
+ mCount(0),
+ mSpeed(speed),
+ mStarted(false),
+ mStartTime(0),
+ mStartEventTime(0)
+{
+#if defined OIS_WIN32_PLATFORM
+	OIS_UNUSED(fileName);
+	OIS_EXCEPT(E_NotSupported, "ReplayFactoryCreator >> Replay is not supported on this platform");
+#else
+	mFd = open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+	if(mFd == -1)
+		OIS_EXCEPT(E_General, "ReplayFactoryCreator >> Could not open recording file");
+
+	struct stat st;
+	if(fstat(mFd, &st) != 0 || st.st_size < (off_t)sizeof(ReplayFileHeader))
+	{
+		close(mFd);
+		OIS_EXCEPT(E_General, "ReplayFactoryCreator >> Not a recording file");
+	}
+
+	mMapSize = (std::size_t)st.st_size;
+	mMap	 = mmap(0, mMapSize, PROT_READ, MAP_PRIVATE, mFd, 0);
+	if(mMap == MAP_FAILED)
+	{
+		close(mFd);
+		OIS_EXCEPT(E_General, "ReplayFactoryCreator >> Could not map recording file");
+	}
+
+	const ReplayFileHeader* header = static_cast<const ReplayFileHeader*>(mMap);
+	if(memcmp(header->magic, "OISR", 4) != 0 || header->version != OIS_REPLAY_VERSION)
+	{
+		munmap(mMap, mMapSize);
+		close(mFd);
+		OIS_EXCEPT(E_General, "ReplayFactoryCreator >> Not a recording file, or from another OIS version");
+	}
+
+	//A recording which was not closed cleanly may claim more events than were written
+	mEvents = reinterpret_cast<const RawEvent*>(header + 1);
+	mCount	= std::min<std::uint64_t>(header->count, (mMapSize - sizeof(ReplayFileHeader)) / sizeof(RawEvent));
+#endif
+
+	//Find all devices, how many components the joysticks used, and when to play each event.
+	//Last timestamp and play time per device, in the same order as mDevices
+	std::vector<std::pair<std::uint64_t, std::uint64_t>> deviceTimes;
+	mPlayTimes.resize((std::size_t)mCount);
+	std::uint64_t playTime = 0;
+	for(std::uint64_t i = 0; i < mCount; ++i)
+	{
+		const RawEvent& evt = mEvents[i];
+		mPlayTimes[(std::size_t)i] = playTime;
+		if(evt.deviceType != OISKeyboard && evt.deviceType != OISMouse && evt.deviceType != OISJoyStick)
+			continue;
+
+		ReplayDeviceList::iterator dev = mDevices.begin();
+		while(dev != mDevices.end() && !(dev->type == evt.deviceType && (std::uint16_t)dev->id == evt.device))
+			++dev;
+
+		if(dev == mDevices.end())
+		{
+			ReplayDevice device = { (Type)evt.deviceType, (std::int16_t)evt.device, 0, 0, 0, 0, 0 };
+			dev					= mDevices.insert(mDevices.end(), device);
+			deviceTimes.push_back(std::make_pair(evt.timestamp, playTime));
+		}
+
+		//Advance by the step since this device's previous event, in that device's own clock
+		std::pair<std::uint64_t, std::uint64_t>& last = deviceTimes[dev - mDevices.begin()];
+		if(evt.timestamp != 0)
+		{
+			if(last.first != 0 && evt.timestamp > last.first)
+				playTime = std::max(playTime, last.second + (evt.timestamp - last.first));
+
+			last.first = evt.timestamp;
+		}
+		last.second				   = playTime;
+		mPlayTimes[(std::size_t)i] = playTime;
+
+		if(evt.type == InputEvent::ButtonPressed || evt.type == InputEvent::ButtonReleased)
+			dev->buttons = std::max(dev->buttons, evt.code + 1);
+		else if(evt.type == InputEvent::AxisMoved)
+			dev->axes = std::max(dev->axes, evt.code + 1);
+		else if(evt.type == InputEvent::PovMoved)
+			dev->povs = std::max(dev->povs, evt.code + 1);
+	}
+}
+
+//---------------------------------------------------------------------------------//
+ReplayFactoryCreator::~ReplayFactoryCreator()
+{
+#if !defined OIS_WIN32_PLATFORM
+	if(mMap)
+		munmap(mMap, mMapSize);
+	if(mFd != -1)
+		close(mFd);
+#endif
+}
+
+//---------------------------------------------------------------------------------//
+DeviceList ReplayFactoryCreator::freeDeviceList()
+{
+	DeviceList list;
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+		if(i->object == 0)
+			list.insert(std::make_pair(i->type, std::string("Replay")));
+
+	return list;
+}
+
+//---------------------------------------------------------------------------------//
+int ReplayFactoryCreator::totalDevices(Type iType)
+{
+	int count = 0;
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+		if(i->type == iType)
+			++count;
+
+	return count;
+}
+
+//---------------------------------------------------------------------------------//
+int ReplayFactoryCreator::freeDevices(Type iType)
+{
+	int count = 0;
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+		if(i->type == iType && i->object == 0)
+			++count;
+
+	return count;
+}
+
+//---------------------------------------------------------------------------------//
+bool ReplayFactoryCreator::vendorExist(Type iType, const std::string& vendor)
+{
+	return vendor == "Replay" && totalDevices(iType) > 0;
+}
+
+//---------------------------------------------------------------------------------//
+Object* ReplayFactoryCreator::createObject(InputManager* creator, Type iType, bool bufferMode, const std::string& vendor)
+{
+	if(!vendor.empty() && vendor != "Replay")
+		OIS_EXCEPT(E_InputDeviceNonExistant, "ReplayFactoryCreator >> No devices of this vendor");
+
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+	{
+		if(i->type != iType || i->object != 0)
+			continue;
+
+		switch(iType)
+		{
+			case OISKeyboard: i->object = new ReplayKeyboard(creator, bufferMode, this, &*i); break;
+			case OISMouse: i->object = new ReplayMouse(creator, bufferMode, this, &*i); break;
+			case OISJoyStick: i->object = new ReplayJoyStick(creator, bufferMode, this, &*i); break;
+			default: break;
+		}
+
+		return i->object;
+	}
+
+	OIS_EXCEPT(E_InputDeviceNonExistant, "ReplayFactoryCreator >> No free devices of this type");
+}
+
+//---------------------------------------------------------------------------------//
+void ReplayFactoryCreator::destroyObject(Object* obj)
+{
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+	{
+		if(i->object == obj)
+		{
+			delete obj;
+			i->object = 0;
+			i->cursor = 0;
+			return;
+		}
+	}
+}
+
+//---------------------------------------------------------------------------------//
+void ReplayFactoryCreator::setSpeed(float speed)
+{
+	//Continue from the current position at the new pace
+	if(mStarted && mSpeed > 0.0f && speed > 0.0f)
+	{
+		mStartEventTime = _getReplayTime();
+		mStartTime		= (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	mSpeed = speed;
+}
+
+//---------------------------------------------------------------------------------//
+void ReplayFactoryCreator::restart()
+{
+	mStarted = false;
+	for(ReplayDeviceList::iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+	{
+		i->cursor = 0;
+		if(i->object)
+			i->object->_initialize();
+	}
+}
+
+//---------------------------------------------------------------------------------//
+bool ReplayFactoryCreator::isFinished() const
+{
+	for(ReplayDeviceList::const_iterator i = mDevices.begin(); i != mDevices.end(); ++i)
+		if(i->object && i->cursor < mCount)
+			return false;
+
+	return true;
+}
+
+//---------------------------------------------------------------------------------//
+std::uint64_t ReplayFactoryCreator::_getReplayTime()
+{
+	std::uint64_t now = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	if(!mStarted)
+	{
+		mStarted		= true;
+		mStartTime		= now;
+		mStartEventTime = 0;
+	}
+
+	if(mSpeed <= 0.0f)
+		return std::numeric_limits<std::uint64_t>::max();
+
+	return mStartEventTime + (std::uint64_t)((double)(now - mStartTime) * mSpeed);
+}
@@ -0,0 +1,563 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#include "OISVirtual.h"
+#include "OISException.h"
+#include <algorithm>
+
+using namespace OIS;
+
+namespace
+{
+	InputEvent makeEvent(InputEvent::EventType type, int code, int value, std::uint64_t time)
+	{
+		InputEvent evt;
+		evt.timestamp = time;
+		evt.value	  = value;
+		evt.code	  = (std::uint16_t)code;
+		evt.type	  = (std::uint16_t)type;
+		return evt;
+	}
+
+	//Applies the queued events in order. When a listener returns false the rest stays queued for the next capture,
+	//returns false in that case so the capture's combined movement is not reported either
+	template <typename T>
+	bool processPending(std::vector<InputEvent>& pending, T* device)
+	{
+		std::size_t done = 0;
+		bool keepGoing	 = true;
+		while(done < pending.size() && keepGoing)
+			keepGoing = device->_processEvent(pending[done++]);
+
+		if(done == pending.size())
+			pending.clear();
+		else
+			pending.erase(pending.begin(), pending.begin() + done);
+
+		return keepGoing;
+	}
+}
+
+//-------------------------------------------------------------------//
+VirtualKeyboard::VirtualKeyboard(InputManager* creator, bool buffered, int devID, const std::string& vendor) :
+ Keyboard(vendor, buffered, devID, creator)
+{
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::injectKeyDown(KeyCode kc, unsigned int text, std::uint64_t time)
+{
+	mPending.push_back(makeEvent(InputEvent::KeyPressed, kc, (int)text, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::injectKeyUp(KeyCode kc, std::uint64_t time)
+{
+	mPending.push_back(makeEvent(InputEvent::KeyReleased, kc, 0, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::inject(const InputEvent& evt)
+{
+	if(evt.type == InputEvent::KeyPressed || evt.type == InputEvent::KeyReleased || evt.type == InputEvent::TextEntered)
+		mPending.push_back(evt);
+}
+
+//-------------------------------------------------------------------//
+bool VirtualKeyboard::isKeyDown(KeyCode key) const
+{
+	return mKeyStates.test(key);
+}
+
+//-------------------------------------------------------------------//
+const std::string& VirtualKeyboard::getAsString(KeyCode kc)
+{
+	//Virtual keys have no layout, use the US key caps like the other keymap-less backends
+	return _getDefaultKeyName(kc);
+}
+
+//-------------------------------------------------------------------//
+KeyCode VirtualKeyboard::getAsKeyCode(const std::string& str)
+{
+	return _getDefaultKeyCode(str);
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::copyKeyStates(char keys[256]) const
+{
+	for(int kc = 0; kc < 256; ++kc)
+		keys[kc] = mKeyStates.test(kc) ? 1 : 0;
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::setBuffered(bool buffered)
+{
+	mBuffered = buffered;
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::capture()
+{
+	_beginFrame();
+	processPending(mPending, this);
+	_flushEvents();
+}
+
+//-------------------------------------------------------------------//
+Interface* VirtualKeyboard::queryInterface(Interface::IType type)
+{
+	OIS_UNUSED(type);
+	return 0;
+}
+
+//-------------------------------------------------------------------//
+void VirtualKeyboard::_initialize()
+{
+	mKeyStates.reset();
+	mModifiers = 0;
+	_beginFrame();
+	mPending.clear();
+}
+
+//-------------------------------------------------------------------//
+bool VirtualKeyboard::_processEvent(const InputEvent& evt)
+{
+	//Recorded text is one code point per event, delivered like a one character commit
+	if(evt.type == InputEvent::TextEntered)
+	{
+		char utf8[4];
+		return _injectText(utf8, encodeUTF8((std::uint32_t)evt.value, utf8), evt.timestamp);
+	}
+
+	KeyCode kc		   = (KeyCode)(evt.code & 0xFF);
+	unsigned int flag = 0;
+	if(kc == KC_LCONTROL || kc == KC_RCONTROL)
+		flag = Ctrl;
+	else if(kc == KC_LSHIFT || kc == KC_RSHIFT)
+		flag = Shift;
+	else if(kc == KC_LMENU || kc == KC_RMENU)
+		flag = Alt;
+
+	if(evt.type == InputEvent::KeyPressed)
+	{
+		mKeyStates.set(kc);
+		mPressedKeys.set(kc);
+		mModifiers |= flag;
+		_queueEvent(InputEvent::KeyPressed, kc, evt.value, evt.timestamp);
+		if(mBuffered && mListener)
+			return mListener->keyPressed(KeyEvent(this, kc, evt.value, evt.timestamp));
+	}
+	else
+	{
+		mKeyStates.set(kc, false);
+		mReleasedKeys.set(kc);
+		mModifiers &= ~flag;
+		_queueEvent(InputEvent::KeyReleased, kc, 0, evt.timestamp);
+		if(mBuffered && mListener)
+			return mListener->keyReleased(KeyEvent(this, kc, 0, evt.timestamp));
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------//
+VirtualMouse::VirtualMouse(InputManager* creator, bool buffered, int devID, const std::string& vendor) :
+ Mouse(vendor, buffered, devID, creator), mMoved(false), mMoveTime(0)
+{
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::injectMove(int dx, int dy, int dz, std::uint64_t time)
+{
+	if(dx)
+		mPending.push_back(makeEvent(InputEvent::MouseMoved, 0, dx, time));
+	if(dy)
+		mPending.push_back(makeEvent(InputEvent::MouseMoved, 1, dy, time));
+	if(dz)
+		mPending.push_back(makeEvent(InputEvent::MouseMoved, 2, dz, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::injectButtonDown(MouseButtonID id, std::uint64_t time)
+{
+	if(id < MB_Left || id > MB_Button7)
+		return;
+
+	mPending.push_back(makeEvent(InputEvent::MousePressed, id, 0, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::injectButtonUp(MouseButtonID id, std::uint64_t time)
+{
+	if(id < MB_Left || id > MB_Button7)
+		return;
+
+	mPending.push_back(makeEvent(InputEvent::MouseReleased, id, 0, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::inject(const InputEvent& evt)
+{
+	//Codes come from callers and recordings, only accept the axes and buttons a mouse has
+	switch(evt.type)
+	{
+		case InputEvent::MouseMoved:
+			if(evt.code <= 3)
+				mPending.push_back(evt);
+			break;
+		case InputEvent::MousePressed:
+		case InputEvent::MouseReleased:
+			if(evt.code <= MB_Button7)
+				mPending.push_back(evt);
+			break;
+		default: break;
+	}
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::setBuffered(bool buffered)
+{
+	mBuffered = buffered;
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::capture()
+{
+	//Clear out last frames values
+	mState.X.rel = 0;
+	mState.Y.rel = 0;
+	mState.Z.rel = 0;
+	mState.H.rel = 0;
+	_beginFrame();
+
+	bool notify = processPending(mPending, this);
+
+	if(mMoved)
+	{
+		if(notify && mBuffered && mListener)
+			mListener->mouseMoved(MouseEvent(this, mState, mMoveTime));
+		mMoved = false;
+	}
+
+	_flushEvents();
+}
+
+//-------------------------------------------------------------------//
+Interface* VirtualMouse::queryInterface(Interface::IType type)
+{
+	OIS_UNUSED(type);
+	return 0;
+}
+
+//-------------------------------------------------------------------//
+void VirtualMouse::_initialize()
+{
+	mState.clear();
+	mMoved = false;
+	_beginFrame();
+	mPending.clear();
+}
+
+//-------------------------------------------------------------------//
+bool VirtualMouse::_processEvent(const InputEvent& evt)
+{
+	switch(evt.type)
+	{
+		case InputEvent::MouseMoved:
+		{
+			Axis& axis = evt.code == 0 ? mState.X : (evt.code == 1 ? mState.Y : (evt.code == 3 ? mState.H : mState.Z));
+			axis.abs += evt.value;
+			axis.rel += evt.value;
+			mMoved	  = true;
+			mMoveTime = evt.timestamp;
+			if(evt.code < 2)
+				_recordMotion(evt.code == 0 ? evt.value : 0, evt.code == 1 ? evt.value : 0, evt.timestamp);
+			_queueEvent(InputEvent::MouseMoved, evt.code, evt.value, evt.timestamp);
+			break;
+		}
+		case InputEvent::MousePressed:
+			mState.buttons |= 1 << evt.code;
+			mPressedButtons |= 1 << evt.code;
+			_queueEvent(InputEvent::MousePressed, evt.code, 0, evt.timestamp);
+			if(mBuffered && mListener)
+				return mListener->mousePressed(MouseEvent(this, mState, evt.timestamp), (MouseButtonID)evt.code);
+			break;
+		case InputEvent::MouseReleased:
+			mState.buttons &= ~(1 << evt.code);
+			mReleasedButtons |= 1 << evt.code;
+			_queueEvent(InputEvent::MouseReleased, evt.code, 0, evt.timestamp);
+			if(mBuffered && mListener)
+				return mListener->mouseReleased(MouseEvent(this, mState, evt.timestamp), (MouseButtonID)evt.code);
+			break;
+		default: break;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------//
+VirtualJoyStick::VirtualJoyStick(InputManager* creator, bool buffered, int devID, int buttons, int axes, int povs, const std::string& vendor) :
+ JoyStick(vendor, buffered, devID, creator)
+{
+	mPOVs = povs;
+	if(mState.mPOV.size() < (std::size_t)povs)
+		mState.mPOV.resize(povs);
+	mState.mButtons.resize(buttons);
+	mState.mAxes.resize(axes);
+	mAxisTime.resize(axes);
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::injectButtonDown(int button, std::uint64_t time)
+{
+	inject(makeEvent(InputEvent::ButtonPressed, button, 1, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::injectButtonUp(int button, std::uint64_t time)
+{
+	inject(makeEvent(InputEvent::ButtonReleased, button, 0, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::injectAxis(int axis, int value, std::uint64_t time)
+{
+	inject(makeEvent(InputEvent::AxisMoved, axis, value, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::injectPov(int pov, int direction, std::uint64_t time)
+{
+	inject(makeEvent(InputEvent::PovMoved, pov, direction, time));
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::inject(const InputEvent& evt)
+{
+	switch(evt.type)
+	{
+		case InputEvent::ButtonPressed:
+		case InputEvent::ButtonReleased:
+			if(evt.code < mState.mButtons.size())
+				mPending.push_back(evt);
+			break;
+		case InputEvent::AxisMoved:
+			if(evt.code < mState.mAxes.size())
+				mPending.push_back(evt);
+			break;
+		case InputEvent::PovMoved:
+			if((int)evt.code < mPOVs)
+				mPending.push_back(evt);
+			break;
+		default: break;
+	}
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::setBuffered(bool buffered)
+{
+	mBuffered = buffered;
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::capture()
+{
+	_beginFrame();
+	bool notify = processPending(mPending, this);
+
+	//All axes are combined into one movement per captured frame
+	if(notify && mBuffered && mListener)
+	{
+		for(std::size_t i = mMovedAxes.findFirst(); i < mMovedAxes.size(); i = mMovedAxes.findNext(i + 1))
+			if(mListener->axisMoved(JoyStickEvent(this, mState, mAxisTime[i]), (int)i) == false)
+				break;
+	}
+
+	_flushEvents();
+}
+
+//-------------------------------------------------------------------//
+Interface* VirtualJoyStick::queryInterface(Interface::IType type)
+{
+	OIS_UNUSED(type);
+	return 0;
+}
+
+//-------------------------------------------------------------------//
+void VirtualJoyStick::_initialize()
+{
+	mState.clear();
+	mAxisDelivered.assign(mState.mAxes.size(), 0);
+	_beginFrame();
+	mPending.clear();
+}
+
+//-------------------------------------------------------------------//
+bool VirtualJoyStick::_processEvent(const InputEvent& evt)
+{
+	switch(evt.type)
+	{
+		case InputEvent::ButtonPressed:
+			mState.mButtons[evt.code] = true;
+			mPressedButtons.set(evt.code);
+			_queueEvent(InputEvent::ButtonPressed, evt.code, 1, evt.timestamp);
+			if(mBuffered && mListener)
+				return mListener->buttonPressed(JoyStickEvent(this, mState, evt.timestamp), evt.code);
+			break;
+		case InputEvent::ButtonReleased:
+			mState.mButtons[evt.code] = false;
+			mReleasedButtons.set(evt.code);
+			_queueEvent(InputEvent::ButtonReleased, evt.code, 0, evt.timestamp);
+			if(mBuffered && mListener)
+				return mListener->buttonReleased(JoyStickEvent(this, mState, evt.timestamp), evt.code);
+			break;
+		case InputEvent::AxisMoved:
+		{
+			int partner = _setAxis(evt.code, evt.value);
+			if(_axisChanged(evt.code))
+			{
+				mMovedAxes.set(evt.code);
+				mAxisTime[evt.code]	 = evt.timestamp;
+				_queueEvent(InputEvent::AxisMoved, evt.code, mState.mAxes[evt.code].abs, evt.timestamp);
+			}
+			if(partner >= 0 && _axisChanged(partner))
+			{
+				mMovedAxes.set(partner);
+				mAxisTime[partner]	= evt.timestamp;
+				_queueEvent(InputEvent::AxisMoved, partner, mState.mAxes[partner].abs, evt.timestamp);
+			}
+			break;
+		}
+		case InputEvent::PovMoved:
+			mState.mPOV[evt.code].direction = evt.value;
+			_queueEvent(InputEvent::PovMoved, evt.code, evt.value, evt.timestamp);
+			if(mBuffered && mListener)
+				return mListener->povMoved(JoyStickEvent(this, mState, evt.timestamp), evt.code);
+			break;
+		default: break;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------//
+VirtualFactoryCreator::VirtualFactoryCreator(int keyboards, int mice, int joySticks, int joyButtons, int joyAxes, int joyPovs) :
+ mKeyboards(keyboards, (Object*)0),
+ mMice(mice, (Object*)0),
+ mJoySticks(joySticks, (Object*)0),
+ mJoyButtons(joyButtons),
+ mJoyAxes(joyAxes),
+ mJoyPovs(joyPovs)
+{
+}
+
+//-------------------------------------------------------------------//
+VirtualFactoryCreator::~VirtualFactoryCreator()
+{
+}
+
+//-------------------------------------------------------------------//
+std::vector<Object*>* VirtualFactoryCreator::_getSlots(Type iType)
+{
+	switch(iType)
+	{
+		case OISKeyboard: return &mKeyboards;
+		case OISMouse: return &mMice;
+		case OISJoyStick: return &mJoySticks;
+		default: return 0;
+	}
+}
+
+//-------------------------------------------------------------------//
+DeviceList VirtualFactoryCreator::freeDeviceList()
+{
+	DeviceList list;
+	const Type types[3] = { OISKeyboard, OISMouse, OISJoyStick };
+	for(int t = 0; t < 3; ++t)
+	{
+		int count = freeDevices(types[t]);
+		for(int i = 0; i < count; ++i)
+			list.insert(std::make_pair(types[t], std::string("Virtual")));
+	}
+
+	return list;
+}
+
+//-------------------------------------------------------------------//
+int VirtualFactoryCreator::totalDevices(Type iType)
+{
+	std::vector<Object*>* slots = _getSlots(iType);
+	return slots ? (int)slots->size() : 0;
+}
+
+//-------------------------------------------------------------------//
+int VirtualFactoryCreator::freeDevices(Type iType)
+{
+	std::vector<Object*>* slots = _getSlots(iType);
+	return slots ? (int)std::count(slots->begin(), slots->end(), (Object*)0) : 0;
+}
+
+//-------------------------------------------------------------------//
+bool VirtualFactoryCreator::vendorExist(Type iType, const std::string& vendor)
+{
+	return vendor == "Virtual" && totalDevices(iType) > 0;
+}
+
+//-------------------------------------------------------------------//
+Object* VirtualFactoryCreator::createObject(InputManager* creator, Type iType, bool bufferMode, const std::string& vendor)
+{
+	std::vector<Object*>* slots = _getSlots(iType);
+	if(slots == 0 || (!vendor.empty() && vendor != "Virtual"))
+		OIS_EXCEPT(E_InputDeviceNonExistant, "VirtualFactoryCreator >> No devices of this type or vendor");
+
+	std::vector<Object*>::iterator slot = std::find(slots->begin(), slots->end(), (Object*)0);
+	if(slot == slots->end())
+		OIS_EXCEPT(E_InputDeviceNonExistant, "VirtualFactoryCreator >> No free devices of this type");
+
+	int id = (int)(slot - slots->begin());
+	switch(iType)
+	{
+		case OISKeyboard: *slot = new VirtualKeyboard(creator, bufferMode, id); break;
+		case OISMouse: *slot = new VirtualMouse(creator, bufferMode, id); break;
+		default: *slot = new VirtualJoyStick(creator, bufferMode, id, mJoyButtons, mJoyAxes, mJoyPovs); break;
+	}
+
+	return *slot;
+}
+
+//-------------------------------------------------------------------//
+void VirtualFactoryCreator::destroyObject(Object* obj)
+{
+	std::vector<Object*>* slots = _getSlots(obj->type());
+	if(slots)
+	{
+		std::vector<Object*>::iterator slot = std::find(slots->begin(), slots->end(), obj);
+		if(slot != slots->end())
+		{
+			*slot = 0;
+			delete obj;
+		}
+	}
+}
@@ -63,7 +63,7 @@ void LIRCControl::setBuffered(bool buffered)
 void LIRCControl::capture()
 {
 	//Anything to read?
-	int entries = mRingBuffer.GetReadAvailable();
+	int entries = mRingBuffer.readAvailable();
 	if(entries <= 0)
 		return;
 
@@ -71,7 +71,7 @@ void LIRCControl::capture()
 	if(entries > OIS_LIRC_EVENT_BUFFER)
 		entries = OIS_LIRC_EVENT_BUFFER;
 
-	mRingBuffer.Read(events, entries);
+	mRingBuffer.read(events, entries);
 
 	//Loop through each event
 	for(int i = 0; i < entries; ++i)
@@ -94,11 +94,11 @@ void LIRCControl::capture()
 //-----------------------------------------------------------------------------------//
 void LIRCControl::queueButtonPressed(const std::string& id)
 {
-	if(mRingBuffer.GetWriteAvailable() > 0)
+	if(mRingBuffer.writeAvailable() > 0)
 	{
 		LIRCEvent evt;
 		evt.button = mInfo.buttonMap[id];
-		mRingBuffer.Write(&evt, 1);
+		mRingBuffer.write(&evt, 1);
 	}
 }
 
@@ -31,6 +31,10 @@ following restrictions:
 
 #include <linux/input.h>
 #include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
 
 //#define OIS_LINUX_JOY_DEBUG
 
@@ -167,7 +171,8 @@ bool EventUtils::isJoyStick(int deviceID, JoyStickInfo& js)
 
 	int buttons			= 0;
 	bool joyButtonFound = false;
-	js.button_map.clear();
+	js.button_map.assign(KEY_MAX + 1, -1);
+	js.axis_map.assign(ABS_MAX + 1, -1);
 
 #ifdef OIS_LINUX_JOY_DEBUG
 	cout << endl
@@ -199,7 +204,7 @@ bool EventUtils::isJoyStick(int deviceID, JoyStickInfo& js)
 		js.vendor	= getName(deviceID);
 		js.buttons	= buttons;
 		js.axes		= info.relAxes.size() + info.absAxes.size();
-		js.hats		= info.hats.size();
+		js.hats		= info.hats.empty() ? 0 : (info.hats.back() - ABS_HAT0X) / 2 + 1; //X/Y axis pair per POV
 #ifdef OIS_LINUX_JOY_DEBUG
 		cout << endl
 			 << "Device name:" << js.vendor << endl;
@@ -225,7 +230,7 @@ bool EventUtils::isJoyStick(int deviceID, JoyStickInfo& js)
 			input_absinfo absinfo;
 			if(ioctl(deviceID, EVIOCGABS(*i), &absinfo) == -1)
 				OIS_EXCEPT(E_General, "Could not read device absolute axis features");
-			js.axis_range[axes] = Range(absinfo.minimum, absinfo.maximum);
+			js.axis_range[axes] = Range(absinfo.minimum, absinfo.maximum, absinfo.flat, absinfo.fuzz);
 
 #ifdef OIS_LINUX_JOY_DEBUG
 			cout << "Axis Mapping ID (hex): " << hex << *i
@@ -239,6 +244,102 @@ bool EventUtils::isJoyStick(int deviceID, JoyStickInfo& js)
 	return joyButtonFound;
 }
 
+//-----------------------------------------------------------------------------//
+bool EventUtils::isMouse(int deviceID)
+{
+	unsigned char rel_bits[1 + REL_MAX / 8];
+	unsigned char key_bits[1 + KEY_MAX / 8];
+	memset(rel_bits, 0, sizeof(rel_bits));
+	memset(key_bits, 0, sizeof(key_bits));
+
+	if(ioctl(deviceID, EVIOCGBIT(EV_REL, sizeof(rel_bits)), rel_bits) == -1
+	   || ioctl(deviceID, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits) == -1)
+		return false;
+
+	return isBitSet(rel_bits, REL_X) && isBitSet(rel_bits, REL_Y) && isBitSet(key_bits, BTN_LEFT);
+}
+
+//-----------------------------------------------------------------------------//
+bool EventUtils::isKeyboard(int deviceID)
+{
+	unsigned char key_bits[1 + KEY_MAX / 8];
+	memset(key_bits, 0, sizeof(key_bits));
+
+	if(ioctl(deviceID, EVIOCGBIT(EV_KEY, sizeof(key_bits)), key_bits) == -1)
+		return false;
+
+	return isBitSet(key_bits, KEY_A) && isBitSet(key_bits, KEY_Z) && isBitSet(key_bits, KEY_SPACE);
+}
+
+//-----------------------------------------------------------------------------//
+void EventUtils::scanKeyboardsAndMice(EventDeviceInfoList& keyboards, EventDeviceInfoList& mice)
+{
+	const string PATH("/dev/input/");
+	const string EVENT_FILE_NAME("event");
+
+	DIR* dir = opendir(PATH.c_str());
+	if(dir == NULL)
+		return;
+
+	struct dirent* ent;
+	while((ent = readdir(dir)) != NULL)
+	{
+		string entry(ent->d_name);
+		if(entry.rfind(EVENT_FILE_NAME, 0) != 0)
+			continue;
+
+		int fd = open((PATH + entry).c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+		if(fd == -1)
+			continue;
+
+		try
+		{
+			EventDeviceInfo info;
+			info.vendor = getName(fd);
+
+			bool keyboard = isKeyboard(fd);
+			bool mouse	  = isMouse(fd);
+
+			info.combined = keyboard && mouse;
+
+			if(keyboard)
+			{
+				info.fd	   = fd;
+				info.devId = (int)keyboards.size();
+				keyboards.push_back(info);
+			}
+
+			//Combined devices (keyboards with a pointing stick or touchpad) get their own descriptor
+			//per object. EVIOCGRAB is exclusive to one descriptor and starves every other reader of
+			//the node, so these are never grabbed (see combined).
+			if(mouse)
+			{
+				info.fd	   = keyboard ? open((PATH + entry).c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC) : fd;
+				info.devId = (int)mice.size();
+				if(info.fd != -1)
+					mice.push_back(info);
+			}
+
+			if(!keyboard && !mouse)
+				close(fd);
+		}
+		catch(...)
+		{
+			close(fd);
+		}
+	}
+
+	closedir(dir);
+}
+
+//-----------------------------------------------------------------------------//
+void EventUtils::closeDevices(EventDeviceInfoList& devices)
+{
+	for(EventDeviceInfoList::iterator i = devices.begin(); i != devices.end(); ++i)
+		close(i->fd);
+	devices.clear();
+}
+
 //-----------------------------------------------------------------------------//
 string EventUtils::getName(int deviceID)
 {
@@ -0,0 +1,112 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.   
+*/
+#include "linux/LinuxEventReader.h"
+
+#include <sys/ioctl.h>
+#include <time.h>
+
+using namespace OIS;
+
+//-------------------------------------------------------------------//
+LinuxEventReader::LinuxEventReader(int fd) :
+ mFd(fd), mRing(0), mOverflow(false)
+{
+	//Default evdev clock is CLOCK_REALTIME, which jumps. Not fatal if unsupported (old kernels, pipes)
+	int clock = CLOCK_MONOTONIC;
+	ioctl(mFd, EVIOCSCLOCKID, &clock);
+}
+
+//-------------------------------------------------------------------//
+LinuxEventReader::~LinuxEventReader()
+{
+	delete mRing;
+}
+
+//-------------------------------------------------------------------//
+int LinuxEventReader::read(input_event* events, int count)
+{
+	if(mRing)
+	{
+		int ret = (int)mRing->read(events, count);
+		if(ret == 0 && count > 0 && mOverflow.load(std::memory_order_acquire))
+		{
+			//Everything queued before the overflow was read, now report the loss
+			events[0]		  = input_event();
+			events[0].type	  = EV_SYN;
+			events[0].code	  = SYN_DROPPED;
+			mOverflow.store(false, std::memory_order_release);
+			return 1;
+		}
+		return ret;
+	}
+
+	int ret = ::read(mFd, events, sizeof(input_event) * count);
+	if(ret < 0)
+		return 0;
+
+	//Determine how many whole events were read
+	return ret / sizeof(input_event);
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventReader::_setThreaded(bool threaded)
+{
+	mOverflow.store(false, std::memory_order_release);
+	if(threaded && mRing == 0)
+		mRing = new RingBuffer<input_event>(EVENT_RINGSIZE);
+	else if(!threaded)
+	{
+		delete mRing;
+		mRing = 0;
+	}
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventReader::_fill()
+{
+	input_event events[JOY_BUFFERSIZE];
+	bool queued = false;
+
+	while(true)
+	{
+		int ret = ::read(mFd, events, sizeof(events));
+		if(ret <= 0)
+			break;
+
+		//Whatever does not fit is dropped, the device is not being captured fast enough. Keep
+		//dropping until the reader noticed, so it resynchronises from a clean frame boundary
+		ret /= sizeof(input_event);
+		if(mOverflow.load(std::memory_order_acquire))
+			continue;
+
+		unsigned int written = mRing->write(events, ret);
+		if((int)written < ret)
+			mOverflow.store(true, std::memory_order_release);
+		queued = true;
+	}
+
+	return queued;
+}
@@ -25,11 +25,19 @@ following restrictions:
 */
 #include "linux/LinuxInputManager.h"
 #include "linux/LinuxKeyboard.h"
+#include "linux/LinuxKeyboardEvents.h"
 #include "linux/LinuxJoyStickEvents.h"
 #include "linux/LinuxMouse.h"
+#include "linux/LinuxMouseEvents.h"
+#include "linux/LinuxEventReader.h"
+#include "linux/EventHelpers.h"
 #include "OISException.h"
+#include <algorithm>
 #include <cstdlib>
 #include <stdio.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <time.h>
 
 using namespace OIS;
 
@@ -43,8 +51,28 @@ LinuxInputManager::LinuxInputManager() :
 	grabMouse	 = true;
 	grabKeyboard = true;
 	hideMouse	 = true;
+	rawMouse	 = true;
 	mGrabs		 = true;
 	keyboardUsed = mouseUsed = false;
+	mEventInput	 = false;
+	mEventGrab	 = true;
+	joySticks	 = 0;
+	eventKeyboards = eventMice = 0;
+	mJoyStickFlat  = false;
+
+	mXDisplay	= 0;
+	mXEventMask = 0;
+	mXKeyboard	= 0;
+	mXMouse		= 0;
+
+	mCapturedGrabs = mGrabs;
+	mEpollFd	   = epoll_create1(EPOLL_CLOEXEC);
+	if(mEpollFd == -1)
+		OIS_EXCEPT(E_General, "LinuxInputManager >> Failed to create epoll set!");
+
+	mThreaded	   = false;
+	mThreadRunning = false;
+	mThreadEpollFd = mThreadWakeFd = mThreadReadyFd = -1;
 
 	//Setup our internal factories
 	mFactories.push_back(this);
@@ -53,8 +81,28 @@ LinuxInputManager::LinuxInputManager() :
 //--------------------------------------------------------------------------------//
 LinuxInputManager::~LinuxInputManager()
 {
+	if(mThreadRunning)
+	{
+		uint64_t wake  = 1;
+		mThreadRunning = false;
+		if(write(mThreadWakeFd, &wake, sizeof(wake)) == sizeof(wake))
+			mInputThread.join();
+		else
+			mInputThread.detach();
+	}
+
+	if(mThreadEpollFd != -1) close(mThreadEpollFd);
+	if(mThreadWakeFd != -1) close(mThreadWakeFd);
+	if(mThreadReadyFd != -1) close(mThreadReadyFd);
+
 	//Close all joysticks
 	LinuxJoyStick::_clearJoys(unusedJoyStickList);
+
+	//And all evdev keyboards and mice
+	EventUtils::closeDevices(unusedEventKeyboards);
+	EventUtils::closeDevices(unusedEventMice);
+
+	close(mEpollFd);
 }
 
 //--------------------------------------------------------------------------------//
@@ -62,6 +110,25 @@ void LinuxInputManager::_initialize(ParamList& paramList)
 {
 	_parseConfigSettings(paramList);
 
+	if(mThreaded)
+	{
+		mThreadEpollFd = epoll_create1(EPOLL_CLOEXEC);
+		mThreadWakeFd  = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		mThreadReadyFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+		if(mThreadEpollFd == -1 || mThreadWakeFd == -1 || mThreadReadyFd == -1)
+			OIS_EXCEPT(E_General, "LinuxInputManager::_initialize >> Failed to setup input thread!");
+
+		//A null pointer marks the wake up descriptor in both sets
+		epoll_event ev;
+		ev.events	= EPOLLIN;
+		ev.data.ptr = 0;
+		epoll_ctl(mThreadEpollFd, EPOLL_CTL_ADD, mThreadWakeFd, &ev);
+		epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mThreadReadyFd, &ev);
+
+		mThreadRunning = true;
+		mInputThread   = std::thread(&LinuxInputManager::_inputThread, this);
+	}
+
 	//Enumerate all devices attached
 	_enumerateDevices();
 }
@@ -69,10 +136,34 @@ void LinuxInputManager::_initialize(ParamList& paramList)
 //--------------------------------------------------------------------------------//
 void LinuxInputManager::_parseConfigSettings(ParamList& paramList)
 {
-	ParamList::iterator i = paramList.find("WINDOW");
+	//--------- Input Thread Settings ------------//
+	ParamList::iterator i = paramList.find("linux_input_thread");
+	if(i != paramList.end())
+		if(i->second == "true")
+			mThreaded = true;
+
+	//--------- Joystick Settings ------------//
+	i = paramList.find("linux_joystick_flat");
+	if(i != paramList.end())
+		if(i->second == "true")
+			mJoyStickFlat = true;
+
+	//--------- evdev Keyboard/Mouse Settings ------------//
+	i = paramList.find("linux_evdev_input");
+	if(i != paramList.end())
+		if(i->second == "true")
+			mEventInput = true;
+
+	i = paramList.find("linux_evdev_grab");
+	if(i != paramList.end())
+		if(i->second == "false")
+			mEventGrab = false;
+
+	i = paramList.find("WINDOW");
 	if(i == paramList.end())
 	{
-		printf("OIS: No Window specified... Not using x11 keyboard/mouse\n");
+		if(!mEventInput)
+			printf("OIS: No Window specified... Not using x11 keyboard/mouse\n");
 		return;
 	}
 
@@ -94,6 +185,11 @@ void LinuxInputManager::_parseConfigSettings(ParamList& paramList)
 	if(i != paramList.end())
 		if(i->second == "false")
 			hideMouse = false;
+
+	i = paramList.find("x11_mouse_raw");
+	if(i != paramList.end())
+		if(i->second == "false")
+			rawMouse = false;
 }
 
 //--------------------------------------------------------------------------------//
@@ -102,6 +198,13 @@ void LinuxInputManager::_enumerateDevices()
 	//Enumerate all attached devices
 	unusedJoyStickList = LinuxJoyStick::_scanJoys();
 	joySticks		   = unusedJoyStickList.size();
+
+	if(mEventInput)
+	{
+		EventUtils::scanKeyboardsAndMice(unusedEventKeyboards, unusedEventMice);
+		eventKeyboards = (int)unusedEventKeyboards.size();
+		eventMice	   = (int)unusedEventMice.size();
+	}
 }
 
 //----------------------------------------------------------------------------//
@@ -118,6 +221,12 @@ DeviceList LinuxInputManager::freeDeviceList()
 			ret.insert(std::make_pair(OISMouse, mInputSystemName));
 	}
 
+	for(EventDeviceInfoList::iterator i = unusedEventKeyboards.begin(); i != unusedEventKeyboards.end(); ++i)
+		ret.insert(std::make_pair(OISKeyboard, i->vendor));
+
+	for(EventDeviceInfoList::iterator i = unusedEventMice.begin(); i != unusedEventMice.end(); ++i)
+		ret.insert(std::make_pair(OISMouse, i->vendor));
+
 	for(JoyStickInfoList::iterator i = unusedJoyStickList.begin(); i != unusedJoyStickList.end(); ++i)
 		ret.insert(std::make_pair(OISJoyStick, i->vendor));
 
@@ -129,8 +238,8 @@ int LinuxInputManager::totalDevices(Type iType)
 {
 	switch(iType)
 	{
-		case OISKeyboard: return window ? 1 : 0;
-		case OISMouse: return window ? 1 : 0;
+		case OISKeyboard: return (window ? 1 : 0) + eventKeyboards;
+		case OISMouse: return (window ? 1 : 0) + eventMice;
 		case OISJoyStick: return joySticks;
 		default: return 0;
 	}
@@ -141,8 +250,8 @@ int LinuxInputManager::freeDevices(Type iType)
 {
 	switch(iType)
 	{
-		case OISKeyboard: return window ? (keyboardUsed ? 0 : 1) : 0;
-		case OISMouse: return window ? (mouseUsed ? 0 : 1) : 0;
+		case OISKeyboard: return (window && !keyboardUsed ? 1 : 0) + (int)unusedEventKeyboards.size();
+		case OISMouse: return (window && !mouseUsed ? 1 : 0) + (int)unusedEventMice.size();
 		case OISJoyStick: return (int)unusedJoyStickList.size();
 		default: return 0;
 	}
@@ -155,6 +264,13 @@ bool LinuxInputManager::vendorExist(Type iType, const std::string& vendor)
 	{
 		return window ? true : false;
 	}
+	else if(iType == OISKeyboard || iType == OISMouse)
+	{
+		EventDeviceInfoList& list = iType == OISKeyboard ? unusedEventKeyboards : unusedEventMice;
+		for(EventDeviceInfoList::iterator i = list.begin(); i != list.end(); ++i)
+			if(i->vendor == vendor)
+				return true;
+	}
 	else if(iType == OISJoyStick)
 	{
 		for(JoyStickInfoList::iterator i = unusedJoyStickList.begin(); i != unusedJoyStickList.end(); ++i)
@@ -170,17 +286,35 @@ Object* LinuxInputManager::createObject(InputManager* creator, Type iType, bool
 {
 	Object* obj = 0;
 
+	//evdev devices are preferred, unless the X device is asked for by name
+	if(vendor != mInputSystemName && (iType == OISKeyboard || iType == OISMouse))
+	{
+		EventDeviceInfoList& list = iType == OISKeyboard ? unusedEventKeyboards : unusedEventMice;
+		for(EventDeviceInfoList::iterator i = list.begin(); i != list.end(); ++i)
+		{
+			if(!vendor.length() || i->vendor == vendor)
+			{
+				if(iType == OISKeyboard)
+					obj = new LinuxEventKeyboard(this, bufferMode, mEventGrab, *i);
+				else
+					obj = new LinuxEventMouse(this, bufferMode, mEventGrab, *i);
+				list.erase(i);
+				return obj;
+			}
+		}
+	}
+
 	switch(iType)
 	{
 		case OISKeyboard: {
-			if(window && keyboardUsed == false)
+			if(window && keyboardUsed == false && (!vendor.length() || vendor == mInputSystemName))
 				obj = new LinuxKeyboard(this, bufferMode, grabKeyboard);
 
 			break;
 		}
 		case OISMouse: {
-			if(window && mouseUsed == false)
-				obj = new LinuxMouse(this, bufferMode, grabMouse, hideMouse);
+			if(window && mouseUsed == false && (!vendor.length() || vendor == mInputSystemName))
+				obj = new LinuxMouse(this, bufferMode, grabMouse, hideMouse, rawMouse);
 
 			break;
 		}
@@ -189,7 +323,7 @@ Object* LinuxInputManager::createObject(InputManager* creator, Type iType, bool
 			{
 				if(!vendor.length() || i->vendor == vendor)
 				{
-					obj = new LinuxJoyStick(this, bufferMode, *i);
+					obj = new LinuxJoyStick(this, bufferMode, *i, mJoyStickFlat);
 					unusedJoyStickList.erase(i);
 					break;
 				}
@@ -215,7 +349,305 @@ void LinuxInputManager::destroyObject(Object* obj)
 		{
 			unusedJoyStickList.push_back(((LinuxJoyStick*)obj)->_getJoyInfo());
 		}
+		else if(LinuxEventKeyboard* keyboard = dynamic_cast<LinuxEventKeyboard*>(obj))
+		{
+			unusedEventKeyboards.push_back(keyboard->_getDeviceInfo());
+		}
+		else if(LinuxEventMouse* mouse = dynamic_cast<LinuxEventMouse*>(obj))
+		{
+			unusedEventMice.push_back(mouse->_getDeviceInfo());
+		}
 
 		delete obj;
 	}
 }
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::captureAll()
+{
+	_captureReady(0);
+}
+
+//----------------------------------------------------------------------------//
+bool LinuxInputManager::waitForInput(int timeoutMs)
+{
+	return _captureReady(timeoutMs);
+}
+
+//----------------------------------------------------------------------------//
+bool LinuxInputManager::_captureReady(int timeoutMs)
+{
+	//Xlib may already hold events read off the socket during another request (grabs, warps),
+	//those never show up in epoll, and a device captured on its own may have left events for
+	//the other one. A grab change also needs the devices captured right away so they can regrab.
+	bool grabChanged = mCapturedGrabs != mGrabs;
+	mCapturedGrabs	 = mGrabs;
+	bool xReady		 = mXDisplay
+		&& (grabChanged || XEventsQueued(mXDisplay, QueuedAlready) > 0
+			|| (mXKeyboard && mXKeyboard->_hasXEvents()) || (mXMouse && mXMouse->_hasXEvents()));
+
+	//Never sleep on something we already know about, and make sure the server has seen
+	//our outstanding requests before we block waiting for its replies
+	if(xReady)
+		timeoutMs = 0;
+	else if(timeoutMs != 0 && mXDisplay)
+		XFlush(mXDisplay);
+
+	Object* readyObjects[EPOLL_BUFFERSIZE];
+	int readyCount	 = 0;
+	bool threadReady = false;
+
+	epoll_event events[EPOLL_BUFFERSIZE];
+	int count = epoll_wait(mEpollFd, events, EPOLL_BUFFERSIZE, timeoutMs);
+	for(int i = 0; i < count; ++i)
+	{
+		void* ptr = events[i].data.ptr;
+		if(ptr == 0)
+		{
+			//The input thread queued events, reset its counter and capture its devices below
+			uint64_t queued;
+			if(read(mThreadReadyFd, &queued, sizeof(queued)) > 0)
+				threadReady = true;
+		}
+		else if(ptr == mXDisplay)
+		{
+			xReady = true;
+		}
+		else if(std::find(readyObjects, readyObjects + readyCount, static_cast<Object*>(ptr)) == readyObjects + readyCount)
+		{
+			readyObjects[readyCount++] = static_cast<Object*>(ptr);
+		}
+	}
+
+	//Only devices with input are captured, so idle ones cost no read() each frame. The rest just
+	//forget the previous frame's relative axes and pressed/released masks. Objects from other
+	//factories (LIRC, user factories) know nothing of our epoll set and are always captured.
+	for(FactoryCreatedObject::iterator i = mFactoryObjects.begin(); i != mFactoryObjects.end(); ++i)
+	{
+		Object* obj = i->first;
+		bool hasInput = i->second != this
+			|| std::find(readyObjects, readyObjects + readyCount, obj) != readyObjects + readyCount
+			|| (xReady && (obj == mXKeyboard || obj == mXMouse))
+			|| (threadReady && _isThreadedDevice(obj));
+
+		if(hasInput)
+			obj->capture();
+		else
+			obj->_clearFrame();
+	}
+
+	return xReady || readyCount > 0 || threadReady;
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_inputThread()
+{
+	epoll_event events[EPOLL_BUFFERSIZE];
+	while(mThreadRunning)
+	{
+		int count = epoll_wait(mThreadEpollFd, events, EPOLL_BUFFERSIZE, -1);
+
+		bool queued = false;
+		{
+			std::lock_guard<std::mutex> lock(mThreadMutex);
+			for(int i = 0; i < count; ++i)
+			{
+				//Skip the wake up descriptor, and readers which went away while we slept
+				LinuxEventReader* reader = static_cast<LinuxEventReader*>(events[i].data.ptr);
+				if(reader == 0)
+					continue;
+
+				for(ThreadedDeviceList::iterator d = mThreadedDevices.begin(); d != mThreadedDevices.end(); ++d)
+				{
+					if(d->second == reader)
+					{
+						queued |= reader->_fill();
+						break;
+					}
+				}
+			}
+		}
+
+		if(queued)
+		{
+			uint64_t one = 1;
+			if(write(mThreadReadyFd, &one, sizeof(one)) != sizeof(one))
+				continue; //Counter is saturated, the game thread has plenty to read already
+		}
+	}
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_registerDevice(int fd, Object* obj)
+{
+	epoll_event ev;
+	ev.events	= EPOLLIN;
+	ev.data.ptr = obj;
+	if(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) == -1)
+		OIS_EXCEPT(E_General, "LinuxInputManager::_registerDevice >> Failed to add device to epoll set!");
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_registerReader(LinuxEventReader* reader, Object* obj)
+{
+	if(!mThreaded)
+	{
+		_registerDevice(reader->getFd(), obj);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mThreadMutex);
+
+	reader->_setThreaded(true);
+
+	epoll_event ev;
+	ev.events	= EPOLLIN;
+	ev.data.ptr = reader;
+	if(epoll_ctl(mThreadEpollFd, EPOLL_CTL_ADD, reader->getFd(), &ev) == -1)
+		OIS_EXCEPT(E_General, "LinuxInputManager::_registerReader >> Failed to add device to input thread!");
+
+	mThreadedDevices.push_back(std::make_pair(obj, reader));
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_unregisterReader(LinuxEventReader* reader)
+{
+	if(!reader->_isThreaded())
+	{
+		_unregisterDevice(reader->getFd());
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mThreadMutex);
+
+	epoll_event ev;
+	epoll_ctl(mThreadEpollFd, EPOLL_CTL_DEL, reader->getFd(), &ev);
+
+	for(ThreadedDeviceList::iterator i = mThreadedDevices.begin(); i != mThreadedDevices.end(); ++i)
+	{
+		if(i->second == reader)
+		{
+			mThreadedDevices.erase(i);
+			break;
+		}
+	}
+
+	reader->_setThreaded(false);
+}
+
+//----------------------------------------------------------------------------//
+bool LinuxInputManager::_isThreadedDevice(Object* obj) const
+{
+	for(ThreadedDeviceList::const_iterator i = mThreadedDevices.begin(); i != mThreadedDevices.end(); ++i)
+		if(i->first == obj)
+			return true;
+
+	return false;
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_unregisterDevice(int fd)
+{
+	epoll_event ev;
+	epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, &ev);
+}
+
+//----------------------------------------------------------------------------//
+Display* LinuxInputManager::_acquireXDisplay(Object* device)
+{
+	if(mXDisplay == 0)
+	{
+		if(!(mXDisplay = XOpenDisplay(0)))
+			OIS_EXCEPT(E_General, "LinuxInputManager::_acquireXDisplay >> Error opening X!");
+
+		//The display itself marks its connection in the epoll set
+		epoll_event ev;
+		ev.events	= EPOLLIN;
+		ev.data.ptr = mXDisplay;
+		if(epoll_ctl(mEpollFd, EPOLL_CTL_ADD, ConnectionNumber(mXDisplay), &ev) == -1)
+		{
+			XCloseDisplay(mXDisplay);
+			mXDisplay = 0;
+			OIS_EXCEPT(E_General, "LinuxInputManager::_acquireXDisplay >> Failed to add X to epoll set!");
+		}
+
+		mXEventMask = 0;
+	}
+
+	if(device->type() == OISKeyboard)
+		mXKeyboard = static_cast<LinuxKeyboard*>(device);
+	else if(device->type() == OISMouse)
+		mXMouse = static_cast<LinuxMouse*>(device);
+
+	return mXDisplay;
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_releaseXDisplay(Object* device)
+{
+	if(device == mXKeyboard)
+		mXKeyboard = 0;
+	if(device == mXMouse)
+		mXMouse = 0;
+
+	if(mXDisplay && mXKeyboard == 0 && mXMouse == 0)
+	{
+		_unregisterDevice(ConnectionNumber(mXDisplay));
+		XCloseDisplay(mXDisplay);
+		mXDisplay	= 0;
+		mXEventMask = 0;
+	}
+}
+
+//----------------------------------------------------------------------------//
+bool LinuxInputManager::_selectXInput(long add, long remove)
+{
+	mXEventMask = (mXEventMask & ~remove) | add;
+	return XSelectInput(mXDisplay, window, mXEventMask) != BadWindow;
+}
+
+//----------------------------------------------------------------------------//
+void LinuxInputManager::_pumpXEvents()
+{
+	if(mXDisplay == 0)
+		return;
+
+	XEvent event;
+	while(XPending(mXDisplay) > 0)
+	{
+		XNextEvent(mXDisplay, &event);
+
+		switch(event.type)
+		{
+			case KeyPress:
+			case KeyRelease:
+			case MappingNotify:
+				if(mXKeyboard)
+					mXKeyboard->_pushXEvent(event);
+				break;
+			case MotionNotify:
+			case ButtonPress:
+			case ButtonRelease:
+			case GenericEvent:
+				if(mXMouse)
+					mXMouse->_pushXEvent(event);
+				break;
+			default: break;
+		}
+	}
+}
+
+//----------------------------------------------------------------------------//
+std::uint64_t LinuxInputManager::_getXTimestamp(Time time)
+{
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	std::uint64_t nowMs = std::uint64_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+
+	//X time wraps every ~49 days, work out how long ago it was modulo 2^32 to restore the high bits
+	std::uint32_t age = std::uint32_t(nowMs) - std::uint32_t(time);
+	if(age > 60000)
+		return std::uint64_t(now.tv_sec) * 1000000000ull + now.tv_nsec;
+
+	return (nowMs - age) * 1000000ull;
+}
@@ -34,8 +34,9 @@ following restrictions:
 #include "OISException.h"
 
 #include <fcntl.h> //Needed to Open a file descriptor
+#include <sys/ioctl.h>
 #include <dirent.h>
-#include <cassert>
+#include <algorithm>
 #include <linux/input.h>
 
 #include <sstream>
@@ -47,8 +48,9 @@ using namespace OIS;
 //#define OIS_LINUX_JOY_DEBUG
 
 //-------------------------------------------------------------------//
-LinuxJoyStick::LinuxJoyStick(InputManager* creator, bool buffered, const JoyStickInfo& js) :
- JoyStick(js.vendor, buffered, js.devId, creator)
+LinuxJoyStick::LinuxJoyStick(InputManager* creator, bool buffered, const JoyStickInfo& js, bool flatDeadZone) :
+ JoyStick(js.vendor, buffered, js.devId, creator),
+ mReader(js.joyFileD)
 {
 	mJoyStick = js.joyFileD;
 
@@ -56,19 +58,44 @@ LinuxJoyStick::LinuxJoyStick(InputManager* creator, bool buffered, const JoyStic
 	mState.mAxes.resize(js.axes);
 	mState.mButtons.clear();
 	mState.mButtons.resize(js.buttons);
+	mAxisTime.resize(js.axes);
 
 	mPOVs = js.hats;
 
-	mButtonMap = js.button_map;
-	mAxisMap   = js.axis_map;
-	mRanges	   = js.axis_range;
+	std::copy(js.button_map.begin(), js.button_map.begin() + KEY_MAX + 1, mButtonMap);
+	std::copy(js.axis_map.begin(), js.axis_map.begin() + ABS_MAX + 1, mAxisMap);
+	std::copy(js.axis_range.begin(), js.axis_range.begin() + ABS_MAX + 1, mRanges);
+
+	//Precompute the rescaling of every axis onto the full OIS range
+	for(int axis = 0; axis <= ABS_MAX; ++axis)
+	{
+		mAxisScale[axis] = 0;
+		mAxisBias[axis]	 = 0;
+		if(axis < js.axes && mRanges[axis].max != mRanges[axis].min)
+		{
+			std::int64_t range = (std::int64_t)mRanges[axis].max - mRanges[axis].min;
+			mAxisScale[axis]   = (((std::int64_t)(JoyStick::MAX_AXIS - JoyStick::MIN_AXIS) << 16) + range / 2) / range;
+			mAxisBias[axis]	   = ((std::int64_t)JoyStick::MAX_AXIS << 16) - mRanges[axis].max * mAxisScale[axis];
+		}
+	}
+
+	//The driver's flat as the initial dead zone, only on request (linux_joystick_flat)
+	for(int axis = 0; flatDeadZone && axis < (int)mState.mAxes.size(); ++axis)
+		if(mRanges[axis].flat > 0)
+			setAxisDeadZone(axis, (int)((mRanges[axis].flat * mAxisScale[axis]) >> 16));
 
 	ff_effect = 0;
+	mDropping = false;
+	mFrame.reserve(64);
+
+	static_cast<LinuxInputManager*>(mCreator)->_registerReader(&mReader, this);
 }
 
 //-------------------------------------------------------------------//
 LinuxJoyStick::~LinuxJoyStick()
 {
+	static_cast<LinuxInputManager*>(mCreator)->_unregisterReader(&mReader);
+
 	EventUtils::removeForceFeedback(&ff_effect);
 }
 
@@ -76,8 +103,12 @@ LinuxJoyStick::~LinuxJoyStick()
 void LinuxJoyStick::_initialize()
 {
 	//Clear old joy state
-	mState.mAxes.resize(mAxisMap.size());
+	mState.mAxes.resize(ABS_MAX + 1 - std::count(mAxisMap, mAxisMap + ABS_MAX + 1, -1));
 	mState.clear();
+	mAxisDelivered.assign(mState.mAxes.size(), 0);
+	_beginFrame();
+	mFrame.clear();
+	mDropping = false;
 
 	//This will create and new us a force feedback structure if it exists
 	EventUtils::enumerateForceFeedback(mJoyStick, &ff_effect);
@@ -89,125 +120,241 @@ void LinuxJoyStick::_initialize()
 //-------------------------------------------------------------------//
 void LinuxJoyStick::capture()
 {
-	static const short POV_MASK[8] = { 0, 0, 1, 1, 2, 2, 3, 3 };
-
-	//Used to determine if an axis has been changed and needs an event
-	bool axisMoved[32] = { false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false };
+	_beginFrame();
+	_processEvents();
+	_flushEvents();
+}
 
-	//We are in non blocking mode - we just read once, and try to fill up buffer
+//-------------------------------------------------------------------//
+void LinuxJoyStick::_processEvents()
+{
+	//We are in non blocking mode (or reading the input thread's ring) - keep reading until empty
 	input_event js[JOY_BUFFERSIZE];
+	bool notify = true;
 	while(true)
 	{
-		int ret = read(mJoyStick, &js, sizeof(struct input_event) * JOY_BUFFERSIZE);
-		if(ret < 0)
+		int ret = mReader.read(js, JOY_BUFFERSIZE);
+		if(ret <= 0)
 			break;
 
-		//Determine how many whole events re read up
-		ret /= sizeof(struct input_event);
 		for(int i = 0; i < ret; ++i)
 		{
-			switch(js[i].type)
+			if(js[i].type != EV_SYN)
+			{
+				//Events of a frame only take effect once the whole frame arrived
+				if(!mDropping)
+					mFrame.push_back(js[i]);
+				continue;
+			}
+
+			if(js[i].code == SYN_DROPPED)
 			{
-				case EV_KEY: //Button
+				//The kernel lost events, ignore everything up to the next report and reread the device state
+				mFrame.clear();
+				mDropping = true;
+				++mDroppedFrames;
+			}
+			else if(js[i].code == SYN_REPORT)
+			{
+				if(mDropping)
 				{
-					int button = mButtonMap[js[i].code];
+					mDropping = false;
+					_resync(js[i]);
+				}
+
+				//A veto only ends the listener calls, the remaining frames must still reach
+				//the state or it drifts from the device
+				notify = _applyFrame(notify);
+			}
+		}
+	}
+
+	//All axes and POVs are combined into one movement per pair per captured frame
+	if(notify && mBuffered && mListener)
+	{
+		for(std::size_t i = mMovedAxes.findFirst(); i < mMovedAxes.size(); i = mMovedAxes.findNext(i + 1))
+			if(mListener->axisMoved(JoyStickEvent(this, mState, mAxisTime[i]), (int)i) == false)
+				return;
+	}
+}
+
+//-------------------------------------------------------------------//
+bool LinuxJoyStick::_applyFrame(bool notify)
+{
+	int povMoved = 0;
+
+	//First update the state with the whole frame, so listeners see one coherent snapshot
+	for(std::size_t i = 0; i < mFrame.size(); ++i)
+	{
+		const input_event& ev = mFrame[i];
+		std::uint64_t time	  = LinuxEventReader::getTimestamp(ev);
+		switch(ev.type)
+		{
+			case EV_KEY: //Button
+			{
+				if(ev.code > KEY_MAX || mButtonMap[ev.code] < 0)
+					break;
+
+				int button = mButtonMap[ev.code];
 
 #ifdef OIS_LINUX_JOY_DEBUG
-					cout << "\nButton Code: " << js[i].code << ", OIS Value: " << button << endl;
+				cout << "\nButton Code: " << ev.code << ", OIS Value: " << button << endl;
 #endif
 
-					//Check to see whether push or released event...
-					if(js[i].value)
+				mState.mButtons[button] = ev.value != 0;
+				if(ev.value)
+				{
+					mPressedButtons.set(button);
+					_queueEvent(InputEvent::ButtonPressed, button, 1, time);
+				}
+				else
+				{
+					mReleasedButtons.set(button);
+					_queueEvent(InputEvent::ButtonReleased, button, 0, time);
+				}
+				break;
+			}
+
+			case EV_ABS: //Absolute Axis
+			{
+				if(ev.code >= ABS_HAT0X && ev.code <= ABS_HAT3Y) //A POV - Max four POVs allowed
+				{
+					int pov = (ev.code - ABS_HAT0X) >> 1;
+					if(pov >= mPOVs)
+						break;
+
+					//Even is X Axis, Odd is Y Axis. We use a bit field, and when this axis is east,
+					//it can't possibly be west too. So clear out the two directions, then refill
+					//it in with the new direction bit.
+					int direction = mState.mPOV[pov].direction;
+					if(((ev.code - ABS_HAT0X) & 1) == 0)
 					{
-						mState.mButtons[button] = true;
-						if(mBuffered && mListener)
-							if(!mListener->buttonPressed(JoyStickEvent(this, mState), button)) return;
+						direction &= ~(Pov::East | Pov::West);
+						if(ev.value < 0) //Left
+							direction |= Pov::West;
+						else if(ev.value > 0) //Right
+							direction |= Pov::East;
 					}
 					else
 					{
-						mState.mButtons[button] = false;
-						if(mBuffered && mListener)
-							if(!mListener->buttonReleased(JoyStickEvent(this, mState), button)) return;
+						direction &= ~(Pov::North | Pov::South);
+						if(ev.value < 0) //Up
+							direction |= Pov::North;
+						else if(ev.value > 0) //Down
+							direction |= Pov::South;
 					}
-					break;
-				}
 
-				case EV_ABS: //Absolute Axis
+					if(direction != mState.mPOV[pov].direction)
+					{
+						mState.mPOV[pov].direction = direction;
+						povMoved |= 1 << pov;
+						_queueEvent(InputEvent::PovMoved, pov, direction, time);
+					}
+				}
+				else if(ev.code <= ABS_MAX && mAxisMap[ev.code] >= 0) //A Stick
 				{
-					//A Stick (BrakeDefine is the highest possible Axis)
-					if(js[i].code <= ABS_BRAKE)
+					int axis = mAxisMap[ev.code];
+
+					std::int64_t value = (ev.value * mAxisScale[axis] + mAxisBias[axis]) >> 16;
+					value			   = std::max<std::int64_t>(JoyStick::MIN_AXIS, std::min<std::int64_t>(JoyStick::MAX_AXIS, value));
+
+					//Batches keep every reported sample, listeners only get the latest per capture
+					int partner = _setAxis(axis, (std::int32_t)value);
+					if(_axisChanged(axis))
 					{
-						int axis = mAxisMap[js[i].code];
-						assert(axis < 32 && "Too many axes (Max supported is 32). Report this to OIS forums!");
-
-						axisMoved[axis] = true;
-
-						//check for rescaling:
-						if(mRanges[axis].min == JoyStick::MIN_AXIS && mRanges[axis].max != JoyStick::MAX_AXIS)
-						{ //Scale is perfect
-							mState.mAxes[axis].abs = js[i].value;
-						}
-						else
-						{ //Rescale
-							float proportion	   = (float)(js[i].value - mRanges[axis].max) / (float)(mRanges[axis].min - mRanges[axis].max);
-							mState.mAxes[axis].abs = (int)(32767.0f - (65535.0f * proportion));
-						}
+						mMovedAxes.set(axis);
+						mAxisTime[axis] = time;
+						_queueEvent(InputEvent::AxisMoved, axis, mState.mAxes[axis].abs, time);
 					}
-					else if(js[i].code <= ABS_HAT3Y) //A POV - Max four POVs allowed
+					if(partner >= 0 && _axisChanged(partner))
 					{
-						//Normalise the POV to between 0-7
-						//Even is X Axis, Odd is Y Axis
-						unsigned char LinuxPovNumber = js[i].code - 16;
-						short OIS_POVIndex			 = POV_MASK[LinuxPovNumber];
-
-						//Handle X Axis first (Even) (left right)
-						if((LinuxPovNumber & 0x0001) == 0)
-						{
-							//Why do this? Because, we use a bit field, and when this axis is east,
-							//it can't possibly be west too. So clear out the two X axes, then refil
-							//it in with the new direction bit.
-							//Clear the East/West Bit Flags first
-							mState.mPOV[OIS_POVIndex].direction &= 0x11110011;
-							if(js[i].value == -1) //Left
-								mState.mPOV[OIS_POVIndex].direction |= Pov::West;
-							else if(js[i].value == 1) //Right
-								mState.mPOV[OIS_POVIndex].direction |= Pov::East;
-						}
-						//Handle Y Axis (Odd) (up down)
-						else
-						{
-							//Clear the North/South Bit Flags first
-							mState.mPOV[OIS_POVIndex].direction &= 0x11111100;
-							if(js[i].value == -1) //Up
-								mState.mPOV[OIS_POVIndex].direction |= Pov::North;
-							else if(js[i].value == 1) //Down
-								mState.mPOV[OIS_POVIndex].direction |= Pov::South;
-						}
-
-						if(mBuffered && mListener)
-							if(mListener->povMoved(JoyStickEvent(this, mState), OIS_POVIndex) == false)
-								return;
+						mMovedAxes.set(partner);
+						mAxisTime[partner] = time;
+						_queueEvent(InputEvent::AxisMoved, partner, mState.mAxes[partner].abs, time);
 					}
-					break;
 				}
+				break;
+			}
 
-				case EV_REL: //Relative Axes (Do any joystick actually have a relative axis?)
+			case EV_REL: //Relative Axes (Do any joystick actually have a relative axis?)
 #ifdef OIS_LINUX_JOY_DEBUG
-					cout << "\nWarning: Relatives axes not supported yet" << endl;
+				cout << "\nWarning: Relatives axes not supported yet" << endl;
 #endif
-					break;
-				default: break;
+				break;
+			default: break;
+		}
+	}
+
+	if(!notify || !mBuffered || !mListener)
+	{
+		mFrame.clear();
+		return notify;
+	}
+
+	//Then tell the listener what changed, in the order it happened
+	bool keepGoing = true;
+	for(std::size_t i = 0; i < mFrame.size() && keepGoing; ++i)
+	{
+		const input_event& ev = mFrame[i];
+		if(ev.type != EV_KEY || ev.code > KEY_MAX || mButtonMap[ev.code] < 0)
+			continue;
+
+		std::uint64_t time = LinuxEventReader::getTimestamp(ev);
+		if(ev.value)
+			keepGoing = mListener->buttonPressed(JoyStickEvent(this, mState, time), mButtonMap[ev.code]);
+		else
+			keepGoing = mListener->buttonReleased(JoyStickEvent(this, mState, time), mButtonMap[ev.code]);
+	}
+
+	std::uint64_t time = mFrame.empty() ? 0 : LinuxEventReader::getTimestamp(mFrame.back());
+	for(int pov = 0; pov < mPOVs && keepGoing; ++pov)
+		if(povMoved & (1 << pov))
+			keepGoing = mListener->povMoved(JoyStickEvent(this, mState, time), pov);
+
+	mFrame.clear();
+	return keepGoing;
+}
+
+//-------------------------------------------------------------------//
+void LinuxJoyStick::_resync(const input_event& report)
+{
+	//Whatever differs from the current state becomes the next frame
+	mFrame.clear();
+	input_event ev = report;
+
+	unsigned char keys[KEY_MAX / 8 + 1] = { 0 };
+	if(ioctl(mJoyStick, EVIOCGKEY(sizeof(keys)), keys) >= 0)
+	{
+		ev.type = EV_KEY;
+		for(int code = 0; code <= KEY_MAX; ++code)
+		{
+			if(mButtonMap[code] < 0)
+				continue;
+
+			bool down = (keys[code >> 3] & (1 << (code & 7))) != 0;
+			if(down != (bool)mState.mButtons[mButtonMap[code]])
+			{
+				ev.code	 = code;
+				ev.value = down ? 1 : 0;
+				mFrame.push_back(ev);
 			}
 		}
 	}
 
-	//All axes and POVs are combined into one movement per pair per captured frame
-	if(mBuffered && mListener)
+	ev.type = EV_ABS;
+	for(int code = 0; code <= ABS_MAX; ++code)
 	{
-		for(int i = 0; i < 32; ++i)
-			if(axisMoved[i])
-				if(mListener->axisMoved(JoyStickEvent(this, mState), i) == false)
-					return;
+		bool hat = code >= ABS_HAT0X && code <= ABS_HAT3Y && ((code - ABS_HAT0X) >> 1) < mPOVs;
+		if(!hat && mAxisMap[code] < 0)
+			continue;
+
+		input_absinfo absinfo;
+		if(ioctl(mJoyStick, EVIOCGABS(code), &absinfo) < 0)
+			continue;
+
+		ev.code	 = code;
+		ev.value = absinfo.value;
+		mFrame.push_back(ev);
 	}
 }
 
@@ -232,9 +379,9 @@ JoyStickInfo LinuxJoyStick::_getJoyInfo()
 	js.axes		  = (int)mState.mAxes.size();
 	js.buttons	  = (int)mState.mButtons.size();
 	js.hats		  = mPOVs;
-	js.button_map = mButtonMap;
-	js.axis_map	  = mAxisMap;
-	js.axis_range = mRanges;
+	js.button_map.assign(mButtonMap, mButtonMap + KEY_MAX + 1);
+	js.axis_map.assign(mAxisMap, mAxisMap + ABS_MAX + 1);
+	js.axis_range.assign(mRanges, mRanges + ABS_MAX + 1);
 
 	return js;
 }
@@ -270,6 +417,7 @@ JoyStickInfoList LinuxJoyStick::_scanJoys()
 					JoyStickInfo js;
 					if(EventUtils::isJoyStick(fd, js))
 					{
+						js.devId = (int)joys.size();
 						joys.push_back(js);
 #ifdef OIS_LINUX_JOY_DEBUG
 						cout << "=> Joystick added to list." << endl;
@@ -31,10 +31,81 @@ following restrictions:
 #include <X11/keysym.h>
 #include <X11/Xutil.h>
 #include <cstring>
+#include <algorithm>
 
 using namespace OIS;
 #include <iostream>
 
+namespace
+{
+	struct KeySymConversion
+	{
+		KeySym keySym;
+		OIS::KeyCode keyCode;
+	};
+
+	//! Explicit conversions for non-text symbols, sorted by KeySym
+	constexpr KeySymConversion SpecialKeySyms[] = {
+		{ XK_Pause, KC_PAUSE },
+		{ XK_Scroll_Lock, KC_SCROLL },
+		{ XK_Home, KC_HOME },
+		{ XK_Left, KC_LEFT },
+		{ XK_Up, KC_UP },
+		{ XK_Right, KC_RIGHT },
+		{ XK_Down, KC_DOWN },
+		{ XK_Page_Up, KC_PGUP },
+		{ XK_Page_Down, KC_PGDOWN },
+		{ XK_End, KC_END },
+		{ XK_Print, KC_SYSRQ },
+		{ XK_Insert, KC_INSERT },
+		{ XK_Menu, KC_APPS },
+		{ XK_KP_Home, KC_NUMPAD7 },
+		{ XK_KP_Left, KC_NUMPAD4 },
+		{ XK_KP_Up, KC_NUMPAD8 },
+		{ XK_KP_Right, KC_NUMPAD6 },
+		{ XK_KP_Down, KC_NUMPAD2 },
+		{ XK_KP_Page_Up, KC_NUMPAD9 },
+		{ XK_KP_Page_Down, KC_NUMPAD3 },
+		{ XK_KP_End, KC_NUMPAD1 },
+		{ XK_KP_Begin, KC_NUMPAD5 },
+		{ XK_KP_Insert, KC_NUMPAD0 },
+		{ XK_KP_Delete, KC_DECIMAL },
+		{ XK_KP_Divide, KC_DIVIDE },
+		{ XK_Shift_L, KC_LSHIFT },
+		{ XK_Shift_R, KC_RSHIFT },
+		{ XK_Alt_L, KC_LMENU },
+		{ XK_Alt_R, KC_RMENU },
+		{ XK_Super_L, KC_LWIN },
+		{ XK_Super_R, KC_RWIN },
+		{ XK_Delete, KC_DELETE }
+	};
+
+	constexpr std::size_t NumSpecialKeySyms = sizeof(SpecialKeySyms) / sizeof(SpecialKeySyms[0]);
+
+	constexpr bool isSortedInPage(std::size_t i)
+	{
+		return i == NumSpecialKeySyms
+			   || ((SpecialKeySyms[i].keySym & ~0xFFul) == 0xFF00
+				   && (i == 0 || SpecialKeySyms[i - 1].keySym < SpecialKeySyms[i].keySym)
+				   && isSortedInPage(i + 1));
+	}
+
+	//_seedKeyMap writes these straight into the function key page
+	static_assert(isSortedInPage(0), "SpecialKeySyms must be unique, sorted and within the function key page");
+
+	struct KeyNameLess
+	{
+		bool operator()(const std::pair<std::string, OIS::KeyCode>& a, const std::pair<std::string, OIS::KeyCode>& b) const { return a.first < b.first; }
+		bool operator()(const std::pair<std::string, OIS::KeyCode>& a, const std::string& b) const { return a.first < b; }
+	};
+
+	struct KeySymLess
+	{
+		bool operator()(const std::pair<KeySym, OIS::KeyCode>& a, const std::pair<KeySym, OIS::KeyCode>& b) const { return a.first < b.first; }
+		bool operator()(const std::pair<KeySym, OIS::KeyCode>& a, KeySym b) const { return a.first < b; }
+	};
+}
+
 //-------------------------------------------------------------------//
 LinuxKeyboard::LinuxKeyboard(InputManager* creator, bool buffered, bool grab) :
  Keyboard(creator->inputSystemName(), buffered, 0, creator), xim(0), ximStyle(0), xic(0)
@@ -47,52 +118,126 @@ LinuxKeyboard::LinuxKeyboard(InputManager* creator, bool buffered, bool grab) :
 
 	static_cast<LinuxInputManager*>(mCreator)->_setKeyboardUsed(true);
 
-	addKeyConversion(XK_Up, KC_UP);
-	addKeyConversion(XK_Down, KC_DOWN);
-	addKeyConversion(XK_Left, KC_LEFT);
-	addKeyConversion(XK_Right, KC_RIGHT);
-
-	addKeyConversion(XK_KP_Divide, KC_DIVIDE);
-
-	addKeyConversion(XK_KP_Home, KC_NUMPAD7);
-	addKeyConversion(XK_KP_Up, KC_NUMPAD8);
-	addKeyConversion(XK_KP_Page_Up, KC_NUMPAD9);
-	addKeyConversion(XK_KP_Left, KC_NUMPAD4);
-	addKeyConversion(XK_KP_Begin, KC_NUMPAD5);
-	addKeyConversion(XK_KP_Right, KC_NUMPAD6);
-	addKeyConversion(XK_KP_End, KC_NUMPAD1);
-	addKeyConversion(XK_KP_Down, KC_NUMPAD2);
-	addKeyConversion(XK_KP_Page_Down, KC_NUMPAD3);
-	addKeyConversion(XK_KP_Insert, KC_NUMPAD0);
-	addKeyConversion(XK_KP_Delete, KC_DECIMAL);
-
-	addKeyConversion(XK_Page_Up, KC_PGUP);
-	addKeyConversion(XK_Page_Down, KC_PGDOWN);
-	addKeyConversion(XK_Home, KC_HOME);
-	addKeyConversion(XK_End, KC_END);
-
-	addKeyConversion(XK_Print, KC_SYSRQ);
-	addKeyConversion(XK_Scroll_Lock, KC_SCROLL);
-	addKeyConversion(XK_Pause, KC_PAUSE);
-
-	addKeyConversion(XK_Shift_R, KC_RSHIFT);
-	addKeyConversion(XK_Shift_L, KC_LSHIFT);
-	addKeyConversion(XK_Alt_R, KC_RMENU);
-	addKeyConversion(XK_Alt_L, KC_LMENU);
-
-	addKeyConversion(XK_Insert, KC_INSERT);
-	addKeyConversion(XK_Delete, KC_DELETE);
-
-	addKeyConversion(XK_Super_L, KC_LWIN);
-	addKeyConversion(XK_Super_R, KC_RWIN);
-	addKeyConversion(XK_Menu, KC_APPS);
+	//Until the keymap is known only the explicit conversions are available
+	_seedKeyMap();
+}
+
+//-------------------------------------------------------------------//
+void LinuxKeyboard::_seedKeyMap()
+{
+	std::fill(mLatinKeyCodes, mLatinKeyCodes + 256, KC_UNASSIGNED);
+	std::fill(mFunctionKeyCodes, mFunctionKeyCodes + 256, KC_UNASSIGNED);
+	std::fill(mKeySyms, mKeySyms + 256, NoSymbol);
+
+	for(std::size_t i = 0; i < NumSpecialKeySyms; ++i)
+	{
+		mFunctionKeyCodes[SpecialKeySyms[i].keySym & 0xFF] = SpecialKeySyms[i].keyCode;
+		mKeySyms[SpecialKeySyms[i].keyCode]				   = SpecialKeySyms[i].keySym;
+	}
+}
+
+//-------------------------------------------------------------------//
+void LinuxKeyboard::_refreshKeyMap()
+{
+	_seedKeyMap();
+	mOtherKeyCodes.clear();
+
+	// Get modifiers masks
+	capsLockMask = XkbKeysymToModifiers(display, XK_Caps_Lock);
+	numLockMask	 = XkbKeysymToModifiers(display, XK_Num_Lock);
+
+	int minKeyCode, maxKeyCode, symsPerKeyCode;
+	XDisplayKeycodes(display, &minKeyCode, &maxKeyCode);
+
+	const int numKeyCodes = maxKeyCode - minKeyCode + 1;
+	KeySym* syms		  = XGetKeyboardMapping(display, minKeyCode, numKeyCodes, &symsPerKeyCode);
+	if(!syms)
+	{
+		_internKeyNames();
+		return;
+	}
+
+	//Same priority as XKeysymToKeycode - lowest level first, then lowest keycode
+	for(int level = 0; level < symsPerKeyCode; ++level)
+	{
+		for(int xkc = std::max(minKeyCode, 9); xkc <= std::min(maxKeyCode, 255 + 8); ++xkc)
+		{
+			KeySym sym = syms[(xkc - minKeyCode) * symsPerKeyCode + level];
+			KeyCode kc = static_cast<KeyCode>(xkc - 8);
+			if(sym == NoSymbol)
+				continue;
+
+			if(level == 0 && mKeySyms[kc] == NoSymbol)
+				mKeySyms[kc] = sym;
+
+			if(sym < 0x100)
+			{
+				if(mLatinKeyCodes[sym] == KC_UNASSIGNED)
+					mLatinKeyCodes[sym] = kc;
+			}
+			else if((sym & ~0xFFul) == 0xFF00)
+			{
+				if(mFunctionKeyCodes[sym & 0xFF] == KC_UNASSIGNED)
+					mFunctionKeyCodes[sym & 0xFF] = kc;
+			}
+			else
+			{
+				mOtherKeyCodes.push_back(std::make_pair(sym, kc));
+			}
+		}
+	}
+
+	XFree(syms);
+
+	//Stable, so the first (highest priority) entry of every KeySym survives unique
+	std::stable_sort(mOtherKeyCodes.begin(), mOtherKeyCodes.end(), KeySymLess());
+	mOtherKeyCodes.erase(std::unique(mOtherKeyCodes.begin(),
+									 mOtherKeyCodes.end(),
+									 [](const std::pair<KeySym, KeyCode>& a, const std::pair<KeySym, KeyCode>& b) { return a.first == b.first; }),
+						 mOtherKeyCodes.end());
+
+	_internKeyNames();
 }
 
-void LinuxKeyboard::addKeyConversion(KeySym x_key, KeyCode ois_key)
+//-------------------------------------------------------------------//
+void LinuxKeyboard::_internKeyNames()
 {
-	keyConversionToOIS.insert(XtoOIS_KeyMap::value_type(x_key, ois_key));
-	keyConversionFromOIS.insert(OIStoX_KeyMap::value_type(ois_key, x_key));
+	//Assigned in place, so references handed out by getAsString stay valid
+	for(int kc = 0; kc < 256; ++kc)
+	{
+		const char* name = mKeySyms[kc] != NoSymbol ? XKeysymToString(mKeySyms[kc]) : 0;
+		mKeyNames[kc].assign(name ? name : "Unknown");
+	}
+
+	mKeyCodesByName.clear();
+	for(KeySym sym = 0; sym < 0x100; ++sym)
+		_addKeyName(sym, mLatinKeyCodes[sym]);
+	for(KeySym sym = 0; sym < 0x100; ++sym)
+		_addKeyName(0xFF00 | sym, mFunctionKeyCodes[sym]);
+	for(KeySymList::const_iterator i = mOtherKeyCodes.begin(); i != mOtherKeyCodes.end(); ++i)
+		_addKeyName(i->first, i->second);
+
+	std::sort(mKeyCodesByName.begin(), mKeyCodesByName.end(), KeyNameLess());
 }
+
+//-------------------------------------------------------------------//
+void LinuxKeyboard::_addKeyName(KeySym keySym, KeyCode kc)
+{
+	if(kc == KC_UNASSIGNED)
+		return;
+
+	const char* name = XKeysymToString(keySym);
+	if(name)
+		mKeyCodesByName.push_back(std::make_pair(std::string(name), kc));
+}
+
+//-------------------------------------------------------------------//
+OIS::KeyCode LinuxKeyboard::_findKeySym(KeySym keySym) const
+{
+	KeySymList::const_iterator i = std::lower_bound(mOtherKeyCodes.begin(), mOtherKeyCodes.end(), keySym, KeySymLess());
+	return (i != mOtherKeyCodes.end() && i->first == keySym) ? i->second : KC_UNASSIGNED;
+}
+
 //-------------------------------------------------------------------//
 void LinuxKeyboard::_initialize()
 {
@@ -101,20 +246,23 @@ void LinuxKeyboard::_initialize()
 		OIS_WARN(E_General, "LinuxKeyboard::_initialize: Failed to set default locale.");
 
 	//Clear our keyboard state buffer
-	memset(&KeyBuffer, 0, 256);
+	mKeyStates.reset();
 	mModifiers = 0;
+	_beginFrame();
 
-	if(display) XCloseDisplay(display);
-	display = 0;
-	window	= static_cast<LinuxInputManager*>(mCreator)->_getWindow();
+	if(mLookupBuffer.size() < 64)
+		mLookupBuffer.resize(64);
 
-	//Create our local X mListener connection
-	if(!(display = XOpenDisplay(0)))
-		OIS_EXCEPT(E_General, "LinuxKeyboard::_initialize >> Error opening X!");
+	if(mXEvents.capacity() < 64)
+		mXEvents.reserve(64);
+	mXEvents.clear();
 
-	// Get modifiers masks
-	capsLockMask = XkbKeysymToModifiers(display, XK_Caps_Lock);
-	numLockMask	 = XkbKeysymToModifiers(display, XK_Num_Lock);
+	//The X connection is shared with the mouse
+	LinuxInputManager* linMan = static_cast<LinuxInputManager*>(mCreator);
+	window					  = linMan->_getWindow();
+	display					  = linMan->_acquireXDisplay(this);
+
+	_refreshKeyMap();
 
 	//Configure locale modifiers
 	if(XSetLocaleModifiers("@im=none") == NULL)
@@ -154,7 +302,7 @@ void LinuxKeyboard::_initialize()
 	}
 
 	//Set it to receive Input events
-	if(XSelectInput(display, window, KeyPressMask | KeyReleaseMask) == BadWindow)
+	if(!linMan->_selectXInput(KeyPressMask | KeyReleaseMask))
 		OIS_EXCEPT(E_General, "LinuxKeyboard::_initialize: X error!");
 
 	if(xim && ximStyle)
@@ -190,69 +338,32 @@ LinuxKeyboard::~LinuxKeyboard()
 
 		if(xim)
 			XCloseIM(xim);
-		XCloseDisplay(display);
-	}
-
-	static_cast<LinuxInputManager*>(mCreator)->_setKeyboardUsed(true);
-}
-
-//-------------------------------------------------------------------//
-unsigned int UTF8ToUTF32(unsigned char* buf)
-{
-	unsigned char& FirstChar = buf[0];
 
-	if(FirstChar < 128)
-		return FirstChar;
-
-	unsigned int val = 0;
-	unsigned int len = 0;
-
-	if((FirstChar & 0xE0) == 0xC0) //2 Chars
-	{
-		len = 2;
-		val = FirstChar & 0x1F;
-	}
-	else if((FirstChar & 0xF0) == 0xE0) //3 Chars
-	{
-		len = 3;
-		val = FirstChar & 0x0F;
-	}
-	else if((FirstChar & 0xF8) == 0xF0) //4 Chars
-	{
-		len = 4;
-		val = FirstChar & 0x07;
-	}
-	else if((FirstChar & 0xFC) == 0xF8) //5 Chars
-	{
-		len = 5;
-		val = FirstChar & 0x03;
-	}
-	else // if((FirstChar & 0xFE) == 0xFC) //6 Chars
-	{
-		len = 6;
-		val = FirstChar & 0x01;
+		LinuxInputManager* linMan = static_cast<LinuxInputManager*>(mCreator);
+		linMan->_selectXInput(0, KeyPressMask | KeyReleaseMask);
+		linMan->_releaseXDisplay(this);
 	}
 
-	for(int i = 1; i < len; i++)
-		val = (val << 6) | (buf[i] & 0x3F);
-
-	return val;
+	static_cast<LinuxInputManager*>(mCreator)->_setKeyboardUsed(false);
 }
 
 //-------------------------------------------------------------------//
 bool LinuxKeyboard::isKeyDown(KeyCode key) const
 {
-	return (KeyBuffer[key]);
+	return mKeyStates.test(key);
 }
 
 //-------------------------------------------------------------------//
 void LinuxKeyboard::capture()
 {
-	XEvent event;
+	_beginFrame();
+
+	//Reads the X connection for the mouse too, its events wait for the mouse's capture
+	static_cast<LinuxInputManager*>(mCreator)->_pumpXEvents();
 
-	while(XPending(display) > 0)
+	for(std::size_t i = 0; i < mXEvents.size(); ++i)
 	{
-		XNextEvent(display, &event);
+		XEvent& event = mXEvents[i];
 
 		if(KeyPress == event.type)
 		{
@@ -260,9 +371,25 @@ void LinuxKeyboard::capture()
 		}
 		else if(KeyRelease == event.type)
 		{
-			_handleKeyRelease(event);
+			if(_isKeyRepeat(i))
+			{
+				XFilterEvent(&event, None);
+				XFilterEvent(&mXEvents[++i], None);
+			}
+			else
+			{
+				_handleKeyRelease(event);
+			}
+		}
+		else if(MappingNotify == event.type && event.xmapping.request != MappingPointer)
+		{
+			XRefreshKeyboardMapping(&event.xmapping);
+			_refreshKeyMap();
 		}
 	}
+	mXEvents.clear();
+
+	_flushEvents();
 
 	//If grabbing mode is on.. Handle focus lost/gained via Alt-Tab and mouse clicks
 	if(grabKeyboard)
@@ -295,39 +422,56 @@ void LinuxKeyboard::capture()
 //-------------------------------------------------------------------//
 void LinuxKeyboard::_handleKeyPress(XEvent& event)
 {
-	XKeyEvent& e = (XKeyEvent&)event;
-	static std::vector<char> buf(32);
-	KeySym keySym;
+	XKeyEvent& e		 = (XKeyEvent&)event;
+	KeySym keySym		 = NoSymbol;
 	unsigned int character = 0;
 	int bytes			   = 0;
-	bool haveChar		   = true;
+	bool haveKey		   = true;
 
-	haveChar = !XFilterEvent(&event, None);
+	bool haveChar = !XFilterEvent(&event, None);
 
 	if(xic)
 	{
 		Status status;
 		do
 		{
-			bytes	   = Xutf8LookupString(xic, &e, &buf[0], buf.size() - 1, &keySym, &status);
-			buf[bytes] = '\0';
-
+			bytes = Xutf8LookupString(xic, &e, &mLookupBuffer[0], (int)mLookupBuffer.size(), &keySym, &status);
 			if(status == XBufferOverflow)
-				buf.resize(buf.size() * 2);
+				mLookupBuffer.resize(mLookupBuffer.size() * 2);
 		} while(status == XBufferOverflow);
+
+		//An input method commit carries text only (no keycode), there is no key to report. A real
+		//key the input method gave no symbol for falls back to the core lookup, as its release does
+		if(status != XLookupKeySym && status != XLookupBoth)
+		{
+			haveKey = e.keycode != 0;
+			if(haveKey)
+				XLookupString(&e, NULL, 0, &keySym, NULL);
+		}
+		if(status != XLookupChars && status != XLookupBoth)
+			bytes = 0;
 	}
 	else
 	{
-		bytes	   = XLookupString(&e, &buf[0], buf.size() - 1, &keySym, NULL);
-		buf[bytes] = '\0';
+		//Without an input context the text is Latin-1, whose bytes are the first 256 code points
+		char latin1[32];
+		int count = XLookupString(&e, latin1, sizeof(latin1), &keySym, NULL);
+		if(mLookupBuffer.size() < sizeof(latin1) * 2)
+			mLookupBuffer.resize(sizeof(latin1) * 2);
+
+		for(int i = 0; i < count; ++i)
+			bytes += (int)encodeUTF8((unsigned char)latin1[i], &mLookupBuffer[bytes]);
 	}
 
-	if(haveChar && bytes > 0)
+	if(!haveChar)
+		bytes = 0;
+
+	if(bytes > 0)
 	{
 		if(mTextMode == Unicode)
-			character = UTF8ToUTF32(reinterpret_cast<unsigned char*>(&buf[0]));
+			decodeUTF8(&mLookupBuffer[0], bytes, &character, 1);
 		else if(mTextMode == Ascii)
-			character = buf[0];
+			character = (unsigned char)mLookupBuffer[0] < 0x80 ? mLookupBuffer[0] : 0;
 	}
 
 	if(e.state & capsLockMask)
@@ -340,8 +484,11 @@ void LinuxKeyboard::_handleKeyPress(XEvent& event)
 	else
 		mModifiers &= ~NumLock;
 
-	KeyCode kc = KeySymToOISKeyCode(keySym);
-	_injectKeyDown(kc, character);
+	const std::uint64_t time = LinuxInputManager::_getXTimestamp(e.time);
+	if(haveKey)
+		_injectKeyDown(KeySymToOISKeyCode(keySym), character, time);
+
+	_injectText(&mLookupBuffer[0], bytes, time);
 
 	//Check for Alt-Tab
 	LinuxInputManager* linMan = static_cast<LinuxInputManager*>(mCreator);
@@ -354,14 +501,15 @@ void LinuxKeyboard::_handleKeyRelease(XEvent& event)
 	XKeyEvent& e = (XKeyEvent&)event;
 	KeySym keySym;
 
+	//Releases without a keycode have no press either, see _handleKeyPress
 	XFilterEvent(&event, None);
-	if(!_isKeyRepeat(event))
-	{
-		XLookupString(&e, NULL, 0, &keySym, NULL);
+	if(e.keycode == 0)
+		return;
 
-		KeyCode kc = KeySymToOISKeyCode(keySym);
-		_injectKeyUp(kc);
-	}
+	XLookupString(&e, NULL, 0, &keySym, NULL);
+
+	KeyCode kc = KeySymToOISKeyCode(keySym);
+	_injectKeyUp(kc, LinuxInputManager::_getXTimestamp(e.time));
 }
 
 //-------------------------------------------------------------------//
@@ -371,10 +519,11 @@ void LinuxKeyboard::setBuffered(bool buffered)
 }
 
 //-------------------------------------------------------------------//
-bool LinuxKeyboard::_injectKeyDown(KeyCode kc, int text)
+bool LinuxKeyboard::_injectKeyDown(KeyCode kc, int text, std::uint64_t time)
 {
 	if(kc > 255) kc = KC_UNASSIGNED;
-	KeyBuffer[kc] = 1;
+	mKeyStates.set(kc);
+	mPressedKeys.set(kc);
 
 	//Turn on modifier flags
 	if(kc == KC_LCONTROL || kc == KC_RCONTROL)
@@ -384,17 +533,19 @@ bool LinuxKeyboard::_injectKeyDown(KeyCode kc, int text)
 	else if(kc == KC_LMENU || kc == KC_RMENU)
 		mModifiers |= Alt;
 
+	_queueEvent(InputEvent::KeyPressed, kc, text, time);
 	if(mBuffered && mListener)
-		return mListener->keyPressed(KeyEvent(this, kc, text));
+		return mListener->keyPressed(KeyEvent(this, kc, text, time));
 
 	return true;
 }
 
 //-------------------------------------------------------------------//
-bool LinuxKeyboard::_injectKeyUp(KeyCode kc)
+bool LinuxKeyboard::_injectKeyUp(KeyCode kc, std::uint64_t time)
 {
 	if(kc > 255) kc = KC_UNASSIGNED;
-	KeyBuffer[kc] = 0;
+	mKeyStates.set(kc, false);
+	mReleasedKeys.set(kc);
 
 	//Turn off modifier flags
 	if(kc == KC_LCONTROL || kc == KC_RCONTROL)
@@ -404,8 +555,9 @@ bool LinuxKeyboard::_injectKeyUp(KeyCode kc)
 	else if(kc == KC_LMENU || kc == KC_RMENU)
 		mModifiers &= ~Alt;
 
+	_queueEvent(InputEvent::KeyReleased, kc, 0, time);
 	if(mBuffered && mListener)
-		return mListener->keyReleased(KeyEvent(this, kc, 0));
+		return mListener->keyReleased(KeyEvent(this, kc, 0, time));
 
 	return true;
 }
@@ -413,28 +565,19 @@ bool LinuxKeyboard::_injectKeyUp(KeyCode kc)
 //-------------------------------------------------------------------//
 const std::string& LinuxKeyboard::getAsString(KeyCode kc)
 {
-	mGetString = "Unknown";
-	char* temp = 0;
-	KeySym sym = OISKeyCodeToKeySym(kc);
-	if(sym != NoSymbol)
-	{
-		temp = XKeysymToString(sym);
-		if(temp)
-			mGetString = temp;
-	}
-
-	return mGetString;
+	return mKeyNames[kc > 255 ? KC_UNASSIGNED : kc];
 }
 
 //-------------------------------------------------------------------//
-OIS::KeyCode LinuxKeyboard::getAsKeyCode(std::string str)
+OIS::KeyCode LinuxKeyboard::getAsKeyCode(const std::string& str)
 {
-	KeySym X11Key = XStringToKeysym(str.c_str());
-	return KeySymToOISKeyCode(X11Key);
+	KeyNameList::const_iterator i = std::lower_bound(mKeyCodesByName.begin(), mKeyCodesByName.end(), str, KeyNameLess());
+	return (i != mKeyCodesByName.end() && i->first == str) ? i->second : KC_UNASSIGNED;
 }
 
 //-------------------------------------------------------------------//
 void LinuxKeyboard::copyKeyStates(char keys[256]) const
 {
-	memcpy(keys, KeyBuffer, 256);
+	for(int kc = 0; kc < 256; ++kc)
+		keys[kc] = mKeyStates.test(kc) ? 1 : 0;
 }
@@ -0,0 +1,368 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+#include "linux/LinuxKeyboardEvents.h"
+#include "linux/LinuxInputManager.h"
+#include "OISEvents.h"
+#include "OISException.h"
+
+#include <algorithm>
+#include <sys/ioctl.h>
+#include <linux/input.h>
+
+using namespace OIS;
+
+namespace
+{
+	//Text of KEY_RESERVED..KEY_SPACE on a US layout, without and with shift
+	const char USLayout[]		 = "\0\x1b" "1234567890-=" "\b\t" "qwertyuiop[]" "\r\0" "asdfghjkl;'`" "\0\\" "zxcvbnm,./" "\0*\0 ";
+	const char USLayoutShifted[] = "\0\x1b" "!@#$%^&*()_+" "\b\t" "QWERTYUIOP{}" "\r\0" "ASDFGHJKL:\"~" "\0|" "ZXCVBNM<>?" "\0*\0 ";
+	static_assert(sizeof(USLayout) == KEY_SPACE + 2 && sizeof(USLayoutShifted) == KEY_SPACE + 2, "Layout must cover KEY_RESERVED..KEY_SPACE");
+
+	//Text of KEY_KP7..KEY_KPDOT while NumLock is on
+	const char USKeypad[] = "789-456+1230.";
+	static_assert(sizeof(USKeypad) == KEY_KPDOT - KEY_KP7 + 2, "Keypad must cover KEY_KP7..KEY_KPDOT");
+
+	//evdev codes above KEY_F12 which have a KeyCode. KEY_ESC..KEY_F12 equal their scan code, like KeyCode
+	const struct
+	{
+		unsigned short code;
+		OIS::KeyCode keyCode;
+	} EventKeyCodes[] = {
+		{ KEY_RO, KC_ABNT_C1 },
+		{ KEY_HENKAN, KC_CONVERT },
+		{ KEY_KATAKANAHIRAGANA, KC_KANA },
+		{ KEY_MUHENKAN, KC_NOCONVERT },
+		{ KEY_KPENTER, KC_NUMPADENTER },
+		{ KEY_RIGHTCTRL, KC_RCONTROL },
+		{ KEY_KPSLASH, KC_DIVIDE },
+		{ KEY_SYSRQ, KC_SYSRQ },
+		{ KEY_RIGHTALT, KC_RMENU },
+		{ KEY_HOME, KC_HOME },
+		{ KEY_UP, KC_UP },
+		{ KEY_PAGEUP, KC_PGUP },
+		{ KEY_LEFT, KC_LEFT },
+		{ KEY_RIGHT, KC_RIGHT },
+		{ KEY_END, KC_END },
+		{ KEY_DOWN, KC_DOWN },
+		{ KEY_PAGEDOWN, KC_PGDOWN },
+		{ KEY_INSERT, KC_INSERT },
+		{ KEY_DELETE, KC_DELETE },
+		{ KEY_MUTE, KC_MUTE },
+		{ KEY_VOLUMEDOWN, KC_VOLUMEDOWN },
+		{ KEY_VOLUMEUP, KC_VOLUMEUP },
+		{ KEY_POWER, KC_POWER },
+		{ KEY_KPEQUAL, KC_NUMPADEQUALS },
+		{ KEY_PAUSE, KC_PAUSE },
+		{ KEY_KPCOMMA, KC_NUMPADCOMMA },
+		{ KEY_YEN, KC_YEN },
+		{ KEY_LEFTMETA, KC_LWIN },
+		{ KEY_RIGHTMETA, KC_RWIN },
+		{ KEY_COMPOSE, KC_APPS },
+		{ KEY_STOP, KC_STOP },
+		{ KEY_CALC, KC_CALCULATOR },
+		{ KEY_SLEEP, KC_SLEEP },
+		{ KEY_WAKEUP, KC_WAKE },
+		{ KEY_MAIL, KC_MAIL },
+		{ KEY_BOOKMARKS, KC_WEBFAVORITES },
+		{ KEY_COMPUTER, KC_MYCOMPUTER },
+		{ KEY_BACK, KC_WEBBACK },
+		{ KEY_FORWARD, KC_WEBFORWARD },
+		{ KEY_NEXTSONG, KC_NEXTTRACK },
+		{ KEY_PLAYPAUSE, KC_PLAYPAUSE },
+		{ KEY_PREVIOUSSONG, KC_PREVTRACK },
+		{ KEY_STOPCD, KC_MEDIASTOP },
+		{ KEY_HOMEPAGE, KC_WEBHOME },
+		{ KEY_REFRESH, KC_WEBREFRESH },
+		{ KEY_F13, KC_F13 },
+		{ KEY_F14, KC_F14 },
+		{ KEY_F15, KC_F15 },
+		{ KEY_SEARCH, KC_WEBSEARCH },
+		{ KEY_MEDIA, KC_MEDIASELECT },
+	};
+
+	//KeyCode of every evdev code, built once so translating an event is a single lookup
+	struct KeyCodeMap
+	{
+		KeyCodeMap()
+		{
+			std::fill(keyCodes, keyCodes + KEY_MAX + 1, KC_UNASSIGNED);
+
+			//84 is unused and KEY_ZENKAKUHANKAKU has no KeyCode
+			for(unsigned int code = KEY_ESC; code <= KEY_F12; ++code)
+				if(code != 84 && code != KEY_ZENKAKUHANKAKU)
+					keyCodes[code] = (OIS::KeyCode)code;
+
+			for(std::size_t i = 0; i < sizeof(EventKeyCodes) / sizeof(EventKeyCodes[0]); ++i)
+				keyCodes[EventKeyCodes[i].code] = EventKeyCodes[i].keyCode;
+		}
+
+		OIS::KeyCode keyCodes[KEY_MAX + 1];
+	};
+
+	const KeyCodeMap EventKeyMap;
+}
+
+//-------------------------------------------------------------------//
+LinuxEventKeyboard::LinuxEventKeyboard(InputManager* creator, bool buffered, bool grab, const EventDeviceInfo& info) :
+ Keyboard(info.vendor, buffered, info.devId, creator),
+ mInfo(info),
+ mReader(info.fd),
+ mGrab(grab),
+ mDropping(false)
+{
+	static_cast<LinuxInputManager*>(mCreator)->_registerReader(&mReader, this);
+}
+
+//-------------------------------------------------------------------//
+LinuxEventKeyboard::~LinuxEventKeyboard()
+{
+	if(mGrab)
+		ioctl(mInfo.fd, EVIOCGRAB, 0);
+
+	static_cast<LinuxInputManager*>(mCreator)->_unregisterReader(&mReader);
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventKeyboard::_initialize()
+{
+	if(mInfo.fd == -1)
+		OIS_EXCEPT(E_InputDeviceNonExistant, "LinuxEventKeyboard::_initialize() >> Keyboard Not Found!");
+
+	//A grab would cut off the mouse reading the same combined node through its own descriptor
+	if(mGrab && mInfo.combined)
+	{
+		mGrab = false;
+		OIS_WARN(E_General, "LinuxEventKeyboard::_initialize: Not grabbing a combined keyboard and mouse device.");
+	}
+	else if(mGrab && ioctl(mInfo.fd, EVIOCGRAB, 1) < 0)
+		OIS_WARN(E_General, "LinuxEventKeyboard::_initialize: Failed to grab the keyboard.");
+
+	mKeyStates.reset();
+	mModifiers = 0;
+	mDropping  = false;
+	_beginFrame();
+
+	//Start with the lock state the keyboard's LEDs show
+	unsigned char leds[LED_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGLED(sizeof(leds)), leds) >= 0)
+	{
+		if(leds[LED_CAPSL >> 3] & (1 << (LED_CAPSL & 7)))
+			mModifiers |= CapsLock;
+		if(leds[LED_NUML >> 3] & (1 << (LED_NUML & 7)))
+			mModifiers |= NumLock;
+	}
+
+	//Keys already held are not reported as pressed
+	unsigned char keys[KEY_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGKEY(sizeof(keys)), keys) >= 0)
+	{
+		for(unsigned int code = 0; code <= KEY_MAX; ++code)
+			if(keys[code >> 3] & (1 << (code & 7)))
+				mKeyStates.set(_toKeyCode(code));
+		mKeyStates.set(KC_UNASSIGNED, false);
+	}
+}
+
+//-------------------------------------------------------------------//
+OIS::KeyCode LinuxEventKeyboard::_toKeyCode(unsigned int code)
+{
+	return code <= KEY_MAX ? EventKeyMap.keyCodes[code] : KC_UNASSIGNED;
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventKeyboard::capture()
+{
+	_beginFrame();
+	_processEvents();
+	_flushEvents();
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventKeyboard::_processEvents()
+{
+	//A veto only ends the listener calls, the rest must still reach the state or keys get stuck
+	bool notify = true;
+	input_event events[64];
+	while(true)
+	{
+		int ret = mReader.read(events, 64);
+		if(ret <= 0)
+			break;
+
+		for(int i = 0; i < ret; ++i)
+		{
+			const input_event& ev = events[i];
+			if(ev.type == EV_SYN)
+			{
+				if(ev.code == SYN_DROPPED)
+				{
+					//The kernel lost events, ignore everything up to the next report and reread the key state
+					mDropping = true;
+				}
+				else if(ev.code == SYN_REPORT && mDropping)
+				{
+					mDropping = false;
+					notify	  = _resync(LinuxEventReader::getTimestamp(ev), notify);
+				}
+			}
+			else if(ev.type == EV_KEY && !mDropping && ev.value != 2) //Auto repeat is not reported, like X
+			{
+				notify = _injectKey(ev.code, ev.value != 0, LinuxEventReader::getTimestamp(ev), notify);
+			}
+		}
+	}
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventKeyboard::_resync(std::uint64_t time, bool notify)
+{
+	unsigned char keys[KEY_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGKEY(sizeof(keys)), keys) < 0)
+		return notify;
+
+	for(unsigned int code = 0; code <= KEY_MAX; ++code)
+	{
+		KeyCode kc = _toKeyCode(code);
+		if(kc == KC_UNASSIGNED)
+			continue;
+
+		bool down = (keys[code >> 3] & (1 << (code & 7))) != 0;
+		if(down != mKeyStates.test(kc))
+			notify = _injectKey(code, down, time, notify);
+	}
+
+	return notify;
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventKeyboard::_injectKey(unsigned int code, bool down, std::uint64_t time, bool notify)
+{
+	KeyCode kc = _toKeyCode(code);
+
+	if(!down)
+	{
+		mKeyStates.set(kc, false);
+		mReleasedKeys.set(kc);
+
+		//Turn off modifier flags
+		if(kc == KC_LCONTROL || kc == KC_RCONTROL)
+			mModifiers &= ~Ctrl;
+		else if(kc == KC_LSHIFT || kc == KC_RSHIFT)
+			mModifiers &= ~Shift;
+		else if(kc == KC_LMENU || kc == KC_RMENU)
+			mModifiers &= ~Alt;
+
+		_queueEvent(InputEvent::KeyReleased, kc, 0, time);
+		if(notify && mBuffered && mListener)
+			return mListener->keyReleased(KeyEvent(this, kc, 0, time));
+
+		return notify;
+	}
+
+	mKeyStates.set(kc);
+	mPressedKeys.set(kc);
+
+	//Turn on modifier flags, the locks toggle on every press
+	if(kc == KC_LCONTROL || kc == KC_RCONTROL)
+		mModifiers |= Ctrl;
+	else if(kc == KC_LSHIFT || kc == KC_RSHIFT)
+		mModifiers |= Shift;
+	else if(kc == KC_LMENU || kc == KC_RMENU)
+		mModifiers |= Alt;
+	else if(kc == KC_CAPITAL)
+		mModifiers ^= CapsLock;
+	else if(kc == KC_NUMLOCK)
+		mModifiers ^= NumLock;
+
+	unsigned int character = mTextMode == Off ? 0 : _translate(code);
+	if(mTextMode == Ascii && character >= 0x80)
+		character = 0;
+
+	_queueEvent(InputEvent::KeyPressed, kc, (int)character, time);
+	if(notify && mBuffered && mListener && !mListener->keyPressed(KeyEvent(this, kc, character, time)))
+		notify = false;
+
+	//Control characters (Enter, Tab...) are keys, not text
+	if(character < 0x20 || (mModifiers & (Ctrl | Alt)))
+		return notify;
+
+	char utf8[4];
+	return _injectText(utf8, encodeUTF8(character, utf8), time, notify);
+}
+
+//-------------------------------------------------------------------//
+unsigned int LinuxEventKeyboard::_translate(unsigned int code) const
+{
+	if(code <= KEY_SPACE)
+	{
+		bool shift = (mModifiers & Shift) != 0;
+		char lower = USLayout[code];
+		if((mModifiers & CapsLock) && lower >= 'a' && lower <= 'z')
+			shift = !shift;
+
+		return (unsigned char)(shift ? USLayoutShifted[code] : lower);
+	}
+
+	if(code >= KEY_KP7 && code <= KEY_KPDOT)
+	{
+		char c = USKeypad[code - KEY_KP7];
+		if((mModifiers & NumLock) || c == '-' || c == '+')
+			return (unsigned char)c;
+	}
+	else if(code == KEY_KPSLASH)
+		return '/';
+	else if(code == KEY_KPENTER)
+		return '\r';
+	else if(code == KEY_KPEQUAL)
+		return '=';
+
+	return 0;
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventKeyboard::setBuffered(bool buffered)
+{
+	mBuffered = buffered;
+}
+
+//-------------------------------------------------------------------//
+const std::string& LinuxEventKeyboard::getAsString(KeyCode kc)
+{
+	return _getDefaultKeyName(kc);
+}
+
+//-------------------------------------------------------------------//
+OIS::KeyCode LinuxEventKeyboard::getAsKeyCode(const std::string& str)
+{
+	return _getDefaultKeyCode(str);
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventKeyboard::copyKeyStates(char keys[256]) const
+{
+	for(int kc = 0; kc < 256; ++kc)
+		keys[kc] = mKeyStates.test(kc) ? 1 : 0;
+}
@@ -28,11 +28,18 @@ following restrictions:
 #include "OISException.h"
 #include "OISEvents.h"
 
+#if defined OIS_LINUX_XI2_SUPPORT
+#include <X11/extensions/XInput2.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+
 using namespace OIS;
 
 //-------------------------------------------------------------------//
-LinuxMouse::LinuxMouse(InputManager* creator, bool buffered, bool grab, bool hide) :
- Mouse(creator->inputSystemName(), buffered, 0, creator)
+LinuxMouse::LinuxMouse(InputManager* creator, bool buffered, bool grab, bool hide, bool raw) :
+ Mouse(creator->inputSystemName(), buffered, 0, creator), useRawMotion(raw), mRawMotion(false), mXIOpcode(0), mPointerId(0)
 {
 	display = 0;
 	window	= 0;
@@ -49,25 +56,40 @@ void LinuxMouse::_initialize()
 {
 	//Clear old state
 	mState.clear();
-	mMoved	= false;
-	mWarped = false;
+	mMoved	  = false;
+	mWarped	  = false;
+	mMoveTime = 0;
+	mRawRemainderX = mRawRemainderY = mRawRemainderZ = mRawRemainderH = 0.0;
+	mScrollSource.source   = 0;
+	mScrollSource.vertical = mScrollSource.horizontal = false;
+	mPointerId			   = 0;
+	mScrollValuators.clear();
+	mScrollSources.clear();
+	_beginFrame();
 
 	//6 is just some random value... hardly ever would anyone have a window smaller than 6
 	oldXMouseX = oldXMouseY = 6;
 	oldXMouseZ				= 0;
 
-	if(display) XCloseDisplay(display);
-	display = 0;
-	window	= static_cast<LinuxInputManager*>(mCreator)->_getWindow();
+	if(mXEvents.capacity() < 64)
+		mXEvents.reserve(64);
+	if(mRawMotions.capacity() < 64)
+		mRawMotions.reserve(64);
+	mXEvents.clear();
+	mRawMotions.clear();
 
-	//Create our local X mListener connection
-	if(!(display = XOpenDisplay(0)))
-		OIS_EXCEPT(E_General, "LinuxMouse::_initialize >> Error opening X!");
+	//The X connection is shared with the keyboard
+	LinuxInputManager* linMan = static_cast<LinuxInputManager*>(mCreator);
+	window					  = linMan->_getWindow();
+	display					  = linMan->_acquireXDisplay(this);
 
 	//Set it to recieve Mouse Input events
-	if(XSelectInput(display, window, ButtonPressMask | ButtonReleaseMask | PointerMotionMask) == BadWindow)
+	if(!linMan->_selectXInput(ButtonPressMask | ButtonReleaseMask | PointerMotionMask))
 		OIS_EXCEPT(E_General, "LinuxMouse::_initialize >> X error!");
 
+	//Prefer unaccelerated device deltas, otherwise grabbing falls back to warping the pointer
+	mRawMotion = useRawMotion && _selectRawMotion();
+
 	//Warp mouse inside window
 	XWarpPointer(display, None, window, 0, 0, 0, 0, 6, 6);
 
@@ -96,7 +118,10 @@ LinuxMouse::~LinuxMouse()
 		grab(false);
 		hide(false);
 		XFreeCursor(display, cursor);
-		XCloseDisplay(display);
+
+		LinuxInputManager* linMan = static_cast<LinuxInputManager*>(mCreator);
+		linMan->_selectXInput(0, ButtonPressMask | ButtonReleaseMask | PointerMotionMask);
+		linMan->_releaseXDisplay(this);
 	}
 
 	static_cast<LinuxInputManager*>(mCreator)->_setMouseUsed(false);
@@ -115,6 +140,8 @@ void LinuxMouse::capture()
 	mState.X.rel = 0;
 	mState.Y.rel = 0;
 	mState.Z.rel = 0;
+	mState.H.rel = 0;
+	_beginFrame();
 
 	_processXEvents();
 
@@ -123,11 +150,13 @@ void LinuxMouse::capture()
 	if(mMoved == true)
 	{
 		if(mBuffered && mListener)
-			mListener->mouseMoved(MouseEvent(this, mState));
+			mListener->mouseMoved(MouseEvent(this, mState, mMoveTime));
 
 		mMoved = false;
 	}
 
+	_flushEvents();
+
 	//Check for losing/gaining mouse grab focus (alt-tab, etc)
 	if(grabMouse)
 	{
@@ -155,106 +184,362 @@ void LinuxMouse::capture()
 //-------------------------------------------------------------------//
 void LinuxMouse::_processXEvents()
 {
-	//X11 Button Events: 1=left 2=middle 3=right; Our Bit Postion: 1=Left 2=Right 3=Middle
-	//X11 Button Events: 8=backward 9=forward; Our Bit Position: 4=backward 5=forward
-	char mask[10] = { 0, 1, 4, 2, 0, 0, 0, 0, 8, 10 };
-	XEvent event;
+	//Reads the X connection for the keyboard too, its events wait for the keyboard's capture
+	static_cast<LinuxInputManager*>(mCreator)->_pumpXEvents();
 
-	//Poll x11 for events mouse events
-	while(XPending(display) > 0)
-	{
-		XNextEvent(display, &event);
+	//Whatever a listener stopped us at stays queued for the next capture
+	std::size_t i = 0, rawIndex = 0;
+	while(i < mXEvents.size() && _processXEvent(mXEvents[i++], rawIndex)) { }
 
-		if(event.type == MotionNotify)
-		{ //Mouse moved
-			//Ignore out of bounds mouse if we just warped
-			if(mWarped)
-			{
-				if(event.xmotion.x < 100 || event.xmotion.x > mState.width - 100 || event.xmotion.y < 100 || event.xmotion.y > mState.height - 100)
-					continue;
-			}
+	mXEvents.erase(mXEvents.begin(), mXEvents.begin() + i);
+	mRawMotions.erase(mRawMotions.begin(), mRawMotions.begin() + rawIndex);
+}
 
-			//Compute this frames Relative X & Y motion
-			int dx = event.xmotion.x - oldXMouseX;
-			int dy = event.xmotion.y - oldXMouseY;
+//-------------------------------------------------------------------//
+bool LinuxMouse::_processXEvent(XEvent& event, std::size_t& rawIndex)
+{
+	//X11 Button Events: 1=left 2=middle 3=right; Our Bit Postion: 1=Left 2=Right 3=Middle
+	//X11 Button Events: 8=backward 9=forward; Our Bit Position: 4=backward 5=forward
+	static const char mask[10] = { 0, 1, 4, 2, 0, 0, 0, 0, 8, 10 };
 
-			//Store old values for next time to compute relative motion
+	if(event.type == MotionNotify)
+	{ //Mouse moved
+		//While grabbed, raw motion replaces the pointer deltas (and the need to warp)
+		if(mRawMotion && grabMouse && mouseFocusLost == false)
+		{
 			oldXMouseX = event.xmotion.x;
 			oldXMouseY = event.xmotion.y;
+			return true;
+		}
 
-			mState.X.abs += dx;
-			mState.Y.abs += dy;
-			mState.X.rel += dx;
-			mState.Y.rel += dy;
+		//Ignore out of bounds mouse if we just warped
+		if(mWarped)
+		{
+			if(event.xmotion.x < 100 || event.xmotion.x > mState.width - 100 || event.xmotion.y < 100 || event.xmotion.y > mState.height - 100)
+				return true;
+		}
+
+		//Compute this frames Relative X & Y motion
+		int dx = event.xmotion.x - oldXMouseX;
+		int dy = event.xmotion.y - oldXMouseY;
+
+		//Store old values for next time to compute relative motion
+		oldXMouseX = event.xmotion.x;
+		oldXMouseY = event.xmotion.y;
 
-			//Check to see if we are grabbing the mouse to the window (requires clipping and warping)
-			if(grabMouse)
+		_addMotion(dx, dy, LinuxInputManager::_getXTimestamp(event.xmotion.time));
+
+		//Check to see if we are grabbing the mouse to the window (requires clipping and warping)
+		if(grabMouse && mouseFocusLost == false)
+		{
+			//Keep mouse in window (fudge factor)
+			if( (event.xmotion.x < 100 || event.xmotion.x > mState.width - 100 || event.xmotion.y < 100 || event.xmotion.y > mState.height - 100) && (dx!=0 || dy!=0) )
 			{
-				if(mState.X.abs < 0)
-					mState.X.abs = 0;
-				else if(mState.X.abs > mState.width)
-					mState.X.abs = mState.width;
-
-				if(mState.Y.abs < 0)
-					mState.Y.abs = 0;
-				else if(mState.Y.abs > mState.height)
-					mState.Y.abs = mState.height;
-
-				if(mouseFocusLost == false)
-				{
-					//Keep mouse in window (fudge factor)
-					if( (event.xmotion.x < 100 || event.xmotion.x > mState.width - 100 || event.xmotion.y < 100 || event.xmotion.y > mState.height - 100) && (dx!=0 || dy!=0) )
-					{
-						oldXMouseX = mState.width >> 1;	 //center x
-						oldXMouseY = mState.height >> 1; //center y
-						XWarpPointer(display, None, window, 0, 0, 0, 0, oldXMouseX, oldXMouseY);
-						mWarped = true;
-					}
-				}
+				oldXMouseX = mState.width >> 1;	 //center x
+				oldXMouseY = mState.height >> 1; //center y
+				XWarpPointer(display, None, window, 0, 0, 0, 0, oldXMouseX, oldXMouseY);
+				mWarped = true;
 			}
-			mMoved = true;
 		}
-		else if(event.type == ButtonPress)
-		{ //Button down
-			static_cast<LinuxInputManager*>(mCreator)->_setGrabState(true);
+	}
+	else if(event.type == GenericEvent)
+	{
+		_processRawMotion(mRawMotions[rawIndex++]);
+	}
+	else if(event.type == ButtonPress)
+	{ //Button down
+		static_cast<LinuxInputManager*>(mCreator)->_setGrabState(true);
 
-			if(event.xbutton.button < 10 && mask[event.xbutton.button])
-			{
-				mState.buttons |= mask[event.xbutton.button];
-				if(mBuffered && mListener)
-					if(mListener->mousePressed(MouseEvent(this, mState),
-											   (MouseButtonID)(mask[event.xbutton.button] >> 1))
-					   == false)
-						return;
-			}
+		if(event.xbutton.button < 10 && mask[event.xbutton.button])
+		{
+			mState.buttons |= mask[event.xbutton.button];
+			mPressedButtons |= mask[event.xbutton.button];
+			_queueEvent(InputEvent::MousePressed, mask[event.xbutton.button] >> 1, 0, LinuxInputManager::_getXTimestamp(event.xbutton.time));
+			if(mBuffered && mListener)
+				if(mListener->mousePressed(MouseEvent(this, mState, LinuxInputManager::_getXTimestamp(event.xbutton.time)),
+										   (MouseButtonID)(mask[event.xbutton.button] >> 1))
+				   == false)
+					return false;
 		}
-		else if(event.type == ButtonRelease)
-		{ //Button up
-			if(event.xbutton.button < 10 && mask[event.xbutton.button])
-			{
-				mState.buttons &= ~mask[event.xbutton.button];
-				if(mBuffered && mListener)
-					if(mListener->mouseReleased(MouseEvent(this, mState),
-												(MouseButtonID)(mask[event.xbutton.button] >> 1))
-					   == false)
-						return;
-			}
-			//The Z axis gets pushed/released pair message (this is up)
-			else if(event.xbutton.button == 4)
-			{
-				mState.Z.rel += 120;
-				mState.Z.abs += 120;
-				mMoved = true;
-			}
-			//The Z axis gets pushed/released pair message (this is down)
-			else if(event.xbutton.button == 5)
+	}
+	else if(event.type == ButtonRelease)
+	{ //Button up
+		if(event.xbutton.button < 10 && mask[event.xbutton.button])
+		{
+			mState.buttons &= ~mask[event.xbutton.button];
+			mReleasedButtons |= mask[event.xbutton.button];
+			_queueEvent(InputEvent::MouseReleased, mask[event.xbutton.button] >> 1, 0, LinuxInputManager::_getXTimestamp(event.xbutton.time));
+			if(mBuffered && mListener)
+				if(mListener->mouseReleased(MouseEvent(this, mState, LinuxInputManager::_getXTimestamp(event.xbutton.time)),
+											(MouseButtonID)(mask[event.xbutton.button] >> 1))
+				   == false)
+					return false;
+		}
+		//The wheels get pushed/released pair messages: 4 up, 5 down, 6 left, 7 right. While raw
+		//events carry smooth scrolling for a wheel these are just its emulation, counting them would double it
+		else if(event.xbutton.button >= 4 && event.xbutton.button <= 7
+				&& !(mRawMotion && grabMouse && mouseFocusLost == false
+					 && (event.xbutton.button <= 5 ? mScrollSource.vertical : mScrollSource.horizontal)))
+		{
+			static const int dz[4] = { 120, -120, 0, 0 };
+			static const int dh[4] = { 0, 0, -120, 120 };
+			_addScroll(dz[event.xbutton.button - 4], dh[event.xbutton.button - 4], LinuxInputManager::_getXTimestamp(event.xbutton.time));
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------//
+void LinuxMouse::_addMotion(int dx, int dy, std::uint64_t time)
+{
+	mState.X.abs += dx;
+	mState.Y.abs += dy;
+	mState.X.rel += dx;
+	mState.Y.rel += dy;
+
+	if(grabMouse)
+	{
+		if(mState.X.abs < 0)
+			mState.X.abs = 0;
+		else if(mState.X.abs > mState.width)
+			mState.X.abs = mState.width;
+
+		if(mState.Y.abs < 0)
+			mState.Y.abs = 0;
+		else if(mState.Y.abs > mState.height)
+			mState.Y.abs = mState.height;
+	}
+
+	mMoved	  = true;
+	mMoveTime = time;
+	_recordMotion(dx, dy, time);
+
+	if(dx)
+		_queueEvent(InputEvent::MouseMoved, 0, dx, mMoveTime);
+	if(dy)
+		_queueEvent(InputEvent::MouseMoved, 1, dy, mMoveTime);
+}
+
+//-------------------------------------------------------------------//
+void LinuxMouse::_addScroll(int dz, int dh, std::uint64_t time)
+{
+	mState.Z.rel += dz;
+	mState.Z.abs += dz;
+	mState.H.rel += dh;
+	mState.H.abs += dh;
+
+	mMoved	  = true;
+	mMoveTime = time;
+
+	if(dz)
+		_queueEvent(InputEvent::MouseMoved, 2, dz, mMoveTime);
+	if(dh)
+		_queueEvent(InputEvent::MouseMoved, 3, dh, mMoveTime);
+}
+
+//-------------------------------------------------------------------//
+bool LinuxMouse::_selectRawMotion()
+{
+#if defined OIS_LINUX_XI2_SUPPORT
+	int event, error;
+	if(!XQueryExtension(display, "XInputExtension", &mXIOpcode, &event, &error))
+		return false;
+
+	//2.1 adds scroll valuators, older servers answer 2.0 and simply never report any
+	int major = 2, minor = 1;
+	if(XIQueryVersion(display, &major, &minor) != Success)
+		return false;
+
+	//Raw events are only reported to the root window. Device changes are wanted from the
+	//masters (slave switches) as well as from the slaves (their valuators changed)
+	unsigned char rawBits[XIMaskLen(XI_LASTEVENT)]	   = { 0 };
+	unsigned char changedBits[XIMaskLen(XI_LASTEVENT)] = { 0 };
+	XISetMask(rawBits, XI_RawMotion);
+	XISetMask(changedBits, XI_DeviceChanged);
+
+	XIEventMask masks[2];
+	masks[0].deviceid = XIAllMasterDevices;
+	masks[0].mask_len = sizeof(rawBits);
+	masks[0].mask	  = rawBits;
+	masks[1].deviceid = XIAllDevices;
+	masks[1].mask_len = sizeof(changedBits);
+	masks[1].mask	  = changedBits;
+
+	return XISelectEvents(display, DefaultRootWindow(display), masks, 2) == Success;
+#else
+	return false;
+#endif
+}
+
+//-------------------------------------------------------------------//
+void LinuxMouse::_pushXEvent(XEvent& event)
+{
+	if(event.type == GenericEvent && !_fetchRawMotion(event))
+		return;
+
+	mXEvents.push_back(event);
+}
+
+//-------------------------------------------------------------------//
+bool LinuxMouse::_fetchRawMotion(XEvent& event)
+{
+#if defined OIS_LINUX_XI2_SUPPORT
+	XGenericEventCookie* cookie = &event.xcookie;
+	if(!mRawMotion || cookie->extension != mXIOpcode || !XGetEventData(display, cookie))
+		return false;
+
+	bool fetched = cookie->evtype == XI_RawMotion;
+	if(fetched)
+	{
+		const XIRawEvent* raw = static_cast<const XIRawEvent*>(cookie->data);
+
+		//Whichever device sent it drives the pointer now
+		mPointerId = raw->deviceid;
+		if(mScrollSource.source != raw->sourceid)
+			mScrollSource = _getScrollSource(raw->sourceid);
+
+		//raw_values holds one entry per set bit of the mask, valuator 0 is X and 1 is Y,
+		//scroll valuators are in steps of their increment
+		const double* value = raw->raw_values;
+		RawMotion motion	= { 0.0, 0.0, 0.0, 0.0, raw->time };
+		for(int i = 0; i < raw->valuators.mask_len * 8; ++i)
+		{
+			if(!XIMaskIsSet(raw->valuators.mask, i))
+				continue;
+
+			if(i == 0)
+				motion.dx = *value;
+			else if(i == 1)
+				motion.dy = *value;
+			else if(const ScrollValuator* scroll = _findScrollValuator(raw->sourceid, i))
 			{
-				mState.Z.rel -= 120;
-				mState.Z.abs -= 120;
-				mMoved = true;
+				//Positive is down and right, Z counts up like the core wheel buttons
+				double notches = *value / scroll->increment;
+				if(scroll->horizontal)
+					motion.dh += notches * 120.0;
+				else
+					motion.dz -= notches * 120.0;
 			}
+			++value;
+		}
+
+		mRawMotions.push_back(motion);
+	}
+	else if(cookie->evtype == XI_DeviceChanged)
+	{
+		const XIDeviceChangedEvent* changed = static_cast<const XIDeviceChangedEvent*>(cookie->data);
+		if(changed->reason == XIDeviceChange)
+			_forgetScrollSource(changed->sourceid);
+
+		//Another device took over our pointer, or the one driving it got new valuators
+		if((changed->reason == XISlaveSwitch && changed->deviceid == mPointerId) || changed->sourceid == mScrollSource.source)
+			mScrollSource = _getScrollSource(changed->sourceid);
+	}
+
+	XFreeEventData(display, cookie);
+	return fetched;
+#else
+	OIS_UNUSED(event);
+	return false;
+#endif
+}
+
+//-------------------------------------------------------------------//
+void LinuxMouse::_processRawMotion(const RawMotion& motion)
+{
+	//Only used while grabbed, the core events keep tracking the cursor otherwise
+	if(!grabMouse || mouseFocusLost)
+		return;
+
+	//Keep the fractions so slow, high resolution movement is not lost
+	mRawRemainderX += motion.dx;
+	mRawRemainderY += motion.dy;
+	double whole;
+	mRawRemainderX = std::modf(mRawRemainderX, &whole);
+	int ix		   = (int)whole;
+	mRawRemainderY = std::modf(mRawRemainderY, &whole);
+	int iy		   = (int)whole;
+
+	if(ix || iy)
+		_addMotion(ix, iy, LinuxInputManager::_getXTimestamp(motion.time));
+
+	//Smooth scrolling accumulates the same way, instead of being rounded to notches
+	mRawRemainderZ += motion.dz;
+	mRawRemainderH += motion.dh;
+	mRawRemainderZ = std::modf(mRawRemainderZ, &whole);
+	int iz		   = (int)whole;
+	mRawRemainderH = std::modf(mRawRemainderH, &whole);
+	int ih		   = (int)whole;
+
+	if(iz || ih)
+		_addScroll(iz, ih, LinuxInputManager::_getXTimestamp(motion.time));
+}
+
+//-------------------------------------------------------------------//
+LinuxMouse::ScrollSource LinuxMouse::_getScrollSource(int source)
+{
+	for(std::size_t i = 0; i < mScrollSources.size(); ++i)
+		if(mScrollSources[i].source == source)
+			return mScrollSources[i];
+
+	ScrollSource device = { source, false, false };
+#if defined OIS_LINUX_XI2_SUPPORT
+	//Each physical device is asked once, and again after its valuators changed
+	int count			= 0;
+	XIDeviceInfo* info = XIQueryDevice(display, source, &count);
+	for(int d = 0; d < count; ++d)
+	{
+		for(int c = 0; c < info[d].num_classes; ++c)
+		{
+			if(info[d].classes[c]->type != XIScrollClass)
+				continue;
+
+			const XIScrollClassInfo* scroll = reinterpret_cast<const XIScrollClassInfo*>(info[d].classes[c]);
+			if(scroll->increment == 0.0)
+				continue;
+
+			ScrollValuator valuator = { source, scroll->number, scroll->scroll_type == XIScrollTypeHorizontal, scroll->increment };
+			mScrollValuators.push_back(valuator);
+			if(valuator.horizontal)
+				device.horizontal = true;
+			else
+				device.vertical = true;
+		}
+	}
+
+	if(info)
+		XIFreeDeviceInfo(info);
+#endif
+	mScrollSources.push_back(device);
+	return device;
+}
+
+//-------------------------------------------------------------------//
+void LinuxMouse::_forgetScrollSource(int source)
+{
+	for(std::size_t i = 0; i < mScrollSources.size(); ++i)
+	{
+		if(mScrollSources[i].source == source)
+		{
+			mScrollSources.erase(mScrollSources.begin() + i);
+			break;
 		}
 	}
+
+	for(std::size_t i = mScrollValuators.size(); i-- > 0;)
+		if(mScrollValuators[i].source == source)
+			mScrollValuators.erase(mScrollValuators.begin() + i);
+}
+
+//-------------------------------------------------------------------//
+const LinuxMouse::ScrollValuator* LinuxMouse::_findScrollValuator(int source, int number) const
+{
+	for(std::size_t i = 0; i < mScrollValuators.size(); ++i)
+		if(mScrollValuators[i].source == source && mScrollValuators[i].number == number)
+			return &mScrollValuators[i];
+
+	return 0;
 }
 
 //-------------------------------------------------------------------//
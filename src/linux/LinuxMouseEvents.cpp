@@ -0,0 +1,283 @@
+/*
+The zlib/libpng License
+
+Copyright (c) 2018 Arthur Brainville
+Copyright (c) 2015 Andrew Fenn
+Copyright (c) 2005-2010 Phillip Castaneda (pjcast -- www.wreckedgames.com)
+
+This software is provided 'as-is', without any express or implied warranty. In no
+event will the authors be held liable for any damages arising from the use of this
+software.
+
+Permission is granted to anyone to use this software for any purpose, including
+commercial applications, and to alter it and redistribute it freely, subject to the
+following restrictions:
+
+    1. The origin of this software must not be misrepresented; you must not claim that
+        you wrote the original software. If you use this software in a product,
+        an acknowledgment in the product documentation would be appreciated
+        but is not required.
+
+    2. Altered source versions must be plainly marked as such, and must not be
+        misrepresented as being the original software.
+
+    3. This notice may not be removed or altered from any source distribution.
+*/
+#include "linux/LinuxMouseEvents.h"
+#include "linux/LinuxInputManager.h"
+#include "OISEvents.h"
+#include "OISException.h"
+
+#include <sys/ioctl.h>
+#include <linux/input.h>
+#include <algorithm>
+
+//Older kernel headers predate high resolution wheels
+#ifndef REL_WHEEL_HI_RES
+#define REL_WHEEL_HI_RES 0x0b
+#define REL_HWHEEL_HI_RES 0x0c
+#endif
+
+using namespace OIS;
+
+namespace
+{
+	//evdev buttons in MouseButtonID order
+	const unsigned short EventButtons[] = { BTN_LEFT, BTN_RIGHT, BTN_MIDDLE, BTN_SIDE, BTN_EXTRA };
+	const int NumEventButtons = sizeof(EventButtons) / sizeof(EventButtons[0]);
+}
+
+//-------------------------------------------------------------------//
+LinuxEventMouse::LinuxEventMouse(InputManager* creator, bool buffered, bool grab, const EventDeviceInfo& info) :
+ Mouse(info.vendor, buffered, info.devId, creator),
+ mInfo(info),
+ mReader(info.fd),
+ mGrab(grab),
+ mDropping(false),
+ mMoved(false),
+ mMoveTime(0),
+ mFrameX(0),
+ mFrameY(0),
+ mHiResWheel(false),
+ mHiResHWheel(false)
+{
+	static_cast<LinuxInputManager*>(mCreator)->_registerReader(&mReader, this);
+}
+
+//-------------------------------------------------------------------//
+LinuxEventMouse::~LinuxEventMouse()
+{
+	if(mGrab)
+		ioctl(mInfo.fd, EVIOCGRAB, 0);
+
+	static_cast<LinuxInputManager*>(mCreator)->_unregisterReader(&mReader);
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventMouse::_initialize()
+{
+	if(mInfo.fd == -1)
+		OIS_EXCEPT(E_InputDeviceNonExistant, "LinuxEventMouse::_initialize() >> Mouse Not Found!");
+
+	//A grab would cut off the keyboard reading the same combined node through its own descriptor
+	if(mGrab && mInfo.combined)
+	{
+		mGrab = false;
+		OIS_WARN(E_General, "LinuxEventMouse::_initialize: Not grabbing a combined keyboard and mouse device.");
+	}
+	else if(mGrab && ioctl(mInfo.fd, EVIOCGRAB, 1) < 0)
+		OIS_WARN(E_General, "LinuxEventMouse::_initialize: Failed to grab the mouse.");
+
+	//Clear mouse state
+	mState.clear();
+	mMoved	  = false;
+	mDropping = false;
+	mFrameX = mFrameY = 0;
+	_beginFrame();
+
+	//Kernels report high resolution wheels both ways, use the fine one when there is one
+	unsigned char relBits[REL_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGBIT(EV_REL, sizeof(relBits)), relBits) >= 0)
+	{
+		mHiResWheel	 = (relBits[REL_WHEEL_HI_RES >> 3] & (1 << (REL_WHEEL_HI_RES & 7))) != 0;
+		mHiResHWheel = (relBits[REL_HWHEEL_HI_RES >> 3] & (1 << (REL_HWHEEL_HI_RES & 7))) != 0;
+	}
+
+	//Buttons already held are not reported as pressed
+	unsigned char keys[KEY_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGKEY(sizeof(keys)), keys) >= 0)
+		for(int id = 0; id < NumEventButtons; ++id)
+			if(keys[EventButtons[id] >> 3] & (1 << (EventButtons[id] & 7)))
+				mState.buttons |= 1 << id;
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventMouse::setBuffered(bool buffered)
+{
+	mBuffered = buffered;
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventMouse::capture()
+{
+	//Clear out last frames values
+	mState.X.rel = 0;
+	mState.Y.rel = 0;
+	mState.Z.rel = 0;
+	mState.H.rel = 0;
+	_beginFrame();
+
+	bool notify = _processEvents();
+
+	if(mMoved)
+	{
+		if(notify && mBuffered && mListener)
+			mListener->mouseMoved(MouseEvent(this, mState, mMoveTime));
+
+		mMoved = false;
+	}
+
+	_flushEvents();
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventMouse::_processEvents()
+{
+	//A veto only ends the listener calls, the rest must still reach the state or it drifts from the device
+	bool notify = true;
+	input_event events[64];
+	while(true)
+	{
+		int ret = mReader.read(events, 64);
+		if(ret <= 0)
+			break;
+
+		for(int i = 0; i < ret; ++i)
+		{
+			const input_event& ev = events[i];
+			std::uint64_t time	  = LinuxEventReader::getTimestamp(ev);
+			if(ev.type == EV_SYN)
+			{
+				if(ev.code == SYN_DROPPED)
+				{
+					//The kernel lost events, ignore everything up to the next report and reread the buttons
+					mDropping = true;
+				}
+				else if(ev.code == SYN_REPORT)
+				{
+					//A report ends one sample of the device, both axes together
+					_recordMotion(mFrameX, mFrameY, time);
+					mFrameX = mFrameY = 0;
+
+					if(mDropping)
+					{
+						mDropping = false;
+						notify	  = _resync(time, notify);
+					}
+				}
+			}
+			else if(mDropping)
+			{
+				continue;
+			}
+			else if(ev.type == EV_REL)
+			{
+				if(ev.code == REL_X)
+					_addMotion(0, ev.value, time);
+				else if(ev.code == REL_Y)
+					_addMotion(1, ev.value, time);
+				else if(ev.code == REL_WHEEL_HI_RES) //Already 120 per notch
+					_addMotion(2, ev.value, time);
+				else if(ev.code == REL_HWHEEL_HI_RES)
+					_addMotion(3, ev.value, time);
+				else if(ev.code == REL_WHEEL && !mHiResWheel)
+					_addMotion(2, ev.value * 120, time);
+				else if(ev.code == REL_HWHEEL && !mHiResHWheel)
+					_addMotion(3, ev.value * 120, time);
+			}
+			else if(ev.type == EV_KEY && ev.value != 2)
+			{
+				for(int id = 0; id < NumEventButtons; ++id)
+				{
+					if(EventButtons[id] != ev.code)
+						continue;
+
+					notify = _injectButton((MouseButtonID)id, ev.value != 0, time, notify);
+					break;
+				}
+			}
+		}
+	}
+
+	return notify;
+}
+
+//-------------------------------------------------------------------//
+void LinuxEventMouse::_addMotion(int axis, int delta, std::uint64_t time)
+{
+	if(delta == 0)
+		return;
+
+	if(axis == 0)
+	{
+		mFrameX += delta;
+		mState.X.rel += delta;
+		mState.X.abs = std::max(0, std::min(mState.width, mState.X.abs + delta));
+	}
+	else if(axis == 1)
+	{
+		mFrameY += delta;
+		mState.Y.rel += delta;
+		mState.Y.abs = std::max(0, std::min(mState.height, mState.Y.abs + delta));
+	}
+	else
+	{
+		Axis& wheel = axis == 2 ? mState.Z : mState.H;
+		wheel.rel += delta;
+		wheel.abs += delta;
+	}
+
+	mMoved	  = true;
+	mMoveTime = time;
+	_queueEvent(InputEvent::MouseMoved, axis, delta, time);
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventMouse::_injectButton(MouseButtonID id, bool down, std::uint64_t time, bool notify)
+{
+	if(down)
+	{
+		mState.buttons |= 1 << id;
+		mPressedButtons |= 1 << id;
+		_queueEvent(InputEvent::MousePressed, id, 0, time);
+		if(notify && mBuffered && mListener)
+			return mListener->mousePressed(MouseEvent(this, mState, time), id);
+	}
+	else
+	{
+		mState.buttons &= ~(1 << id);
+		mReleasedButtons |= 1 << id;
+		_queueEvent(InputEvent::MouseReleased, id, 0, time);
+		if(notify && mBuffered && mListener)
+			return mListener->mouseReleased(MouseEvent(this, mState, time), id);
+	}
+
+	return notify;
+}
+
+//-------------------------------------------------------------------//
+bool LinuxEventMouse::_resync(std::uint64_t time, bool notify)
+{
+	unsigned char keys[KEY_MAX / 8 + 1] = { 0 };
+	if(ioctl(mInfo.fd, EVIOCGKEY(sizeof(keys)), keys) < 0)
+		return notify;
+
+	for(int id = 0; id < NumEventButtons; ++id)
+	{
+		bool down = (keys[EventButtons[id] >> 3] & (1 << (EventButtons[id] & 7))) != 0;
+		if(down != mState.buttonDown((MouseButtonID)id))
+			notify = _injectButton((MouseButtonID)id, down, time, notify);
+	}
+
+	return notify;
+}
@@ -108,6 +108,7 @@ void CocoaJoyStick::capture()
 				std::vector<IOHIDElementCookie>::iterator buttonIt = std::find(mCookies.buttonCookies.begin(), mCookies.buttonCookies.end(), event.elementCookie);
 				int button										   = std::distance(mCookies.buttonCookies.begin(), buttonIt);
 				mState.mButtons[button]							   = (event.value == 1);
+				_queueEvent(event.value == 1 ? InputEvent::ButtonPressed : InputEvent::ButtonReleased, button, 0, 0);
 
 				if(mBuffered && mListener)
 				{
@@ -129,12 +130,15 @@ void CocoaJoyStick::capture()
 				float proportion		 = (float)(event.value - axisInfo.max) / (float)(axisInfo.min - axisInfo.max);
 				mState.mAxes[axis].abs   = -JoyStick::MIN_AXIS - (JoyStick::MAX_AXIS * 2 * proportion);
 
+				_queueEvent(InputEvent::AxisMoved, axis, mState.mAxes[axis].abs, 0);
 				if(mBuffered && mListener) mListener->axisMoved(JoyStickEvent(this, mState), axis);
 				break;
 		}
 
 		result = (*mQueue)->getNextEvent(mQueue, &event, zeroTime, 0);
 	}
+
+	_flushEvents();
 }
 
 //--------------------------------------------------------------------------------------------------//
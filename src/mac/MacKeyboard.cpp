@@ -142,6 +142,9 @@ bool MacKeyboard::isKeyDown(KeyCode key) const
 //-------------------------------------------------------------------//
 void MacKeyboard::capture()
 {
+	// queued by injectEvent, whether or not a listener is set
+	_flushEvents();
+
 	// if not buffered just return, we update the unbuffered automatically
 	if(!mBuffered || !mListener)
 		return;
@@ -328,6 +331,12 @@ void MacKeyboard::injectEvent(KeyCode kc, unsigned int time, MacEventType type,
 	// set to 1 if this is either a keydown or repeat
 	KeyBuffer[kc] = (type == MAC_KEYUP) ? 0 : 1;
 
+	//Carbon event times are truncated to whole seconds here, so log them as unknown
+	if(type == MAC_KEYUP)
+		_queueEvent(InputEvent::KeyReleased, kc, 0, 0);
+	else
+		_queueEvent(InputEvent::KeyPressed, kc, txt, 0);
+
 	if(mBuffered && mListener)
 		pendingEvents.push_back(MacKeyStackEvent(KeyEvent(this, kc, txt), type));
 }
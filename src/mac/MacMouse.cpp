@@ -183,12 +183,22 @@ void MacMouse::capture()
 
 		mState.Z.abs += mTempState.Z.rel;
 
+		if(mState.X.rel)
+			_queueEvent(InputEvent::MouseMoved, 0, mState.X.rel, 0);
+		if(mState.Y.rel)
+			_queueEvent(InputEvent::MouseMoved, 1, mState.Y.rel, 0);
+		if(mState.Z.rel)
+			_queueEvent(InputEvent::MouseMoved, 2, mState.Z.rel, 0);
+
 		//Fire off event
 		if(mListener && mBuffered)
 			mListener->mouseMoved(MouseEvent(this, mState));
 	}
 
 	mTempState.clear();
+
+	//Button events were queued by _mouseCallback as they arrived
+	_flushEvents();
 }
 
 void MacMouse::_mouseCallback(EventRef theEvent)
@@ -283,6 +293,7 @@ void MacMouse::_mouseCallback(EventRef theEvent)
 				mState.buttons |= 1 << mouseButton;
 			}
 
+			_queueEvent(InputEvent::MousePressed, mouseButton, 0, 0);
 			if(mListener && mBuffered)
 				mListener->mousePressed(MouseEvent(this, mState), (MouseButtonID)mouseButton);
 
@@ -343,6 +354,7 @@ void MacMouse::_mouseCallback(EventRef theEvent)
 				mState.buttons &= ~(1 << mouseButton);
 			}
 
+			_queueEvent(InputEvent::MouseReleased, mouseButton, 0, 0);
 			if(mListener && mBuffered)
 				mListener->mouseReleased(MouseEvent(this, mState), (MouseButtonID)mouseButton);
 
@@ -260,12 +260,17 @@ void Win32JoyStick::capture()
 #ifdef OIS_WIN32_XINPUT_SUPPORT
 	//handle xbox controller differently
 	if(mJoyInfo.isXInput)
-	{
 		captureXInput();
-		return;
-	}
+	else
 #endif
+		_captureDirectInput();
 
+	_flushEvents();
+}
+
+//--------------------------------------------------------------------------------------------------//
+void Win32JoyStick::_captureDirectInput()
+{
 	//handle directinput based devices
 	DIDEVICEOBJECTDATA diBuff[JOYSTICK_DX_BUFFERSIZE];
 	DWORD entries = JOYSTICK_DX_BUFFERSIZE;
@@ -370,6 +375,7 @@ void Win32JoyStick::capture()
 						mState.mAxes[axis].absOnly = false;
 						mState.mAxes[axis].abs	   = diBuff[i].dwData;
 						axisMoved[axis]			   = true;
+						_queueEvent(InputEvent::AxisMoved, axis, (int)diBuff[i].dwData, (std::uint64_t)diBuff[i].dwTimeStamp * 1000000);
 					}
 				}
 
@@ -469,11 +475,20 @@ void Win32JoyStick::captureXInput()
 		pov |= Pov::East;
 
 	//Buttons - The first 4 buttons don't need to be checked since they represent the dpad
-	bool previousButtons[XINPUT_TRANSLATED_BUTTON_COUNT];
-	std::copy(mState.mButtons.begin(), mState.mButtons.end(), previousButtons);
+	const BitSet previousButtons = mState.mButtons;
 	for(size_t i = 0; i < XINPUT_TRANSLATED_BUTTON_COUNT; i++)
 		mState.mButtons[i] = (inputState.Gamepad.wButtons & (1 << (i + 4))) != 0;
 
+	//XInput state has no timestamps, polled events are logged with 0
+	for(int i = 0; i < XINPUT_TRANSLATED_AXIS_COUNT; i++)
+		if(axisMoved[i])
+			_queueEvent(InputEvent::AxisMoved, i, mState.mAxes[i].abs, 0);
+	if(previousPov != pov)
+		_queueEvent(InputEvent::PovMoved, 0, pov, 0);
+	for(int i = 0; i < XINPUT_TRANSLATED_BUTTON_COUNT; i++)
+		if(previousButtons[i] != mState.mButtons[i])
+			_queueEvent(mState.mButtons[i] ? InputEvent::ButtonPressed : InputEvent::ButtonReleased, i, 0, 0);
+
 	//Send events
 	if(mBuffered && mListener)
 	{
@@ -514,12 +529,14 @@ bool Win32JoyStick::_doButtonClick(int button, DIDEVICEOBJECTDATA& di)
 	if(di.dwData & 0x80)
 	{
 		mState.mButtons[button] = true;
+		_queueEvent(InputEvent::ButtonPressed, button, 0, (std::uint64_t)di.dwTimeStamp * 1000000);
 		if(mBuffered && mListener)
 			return mListener->buttonPressed(JoyStickEvent(this, mState), button);
 	}
 	else
 	{
 		mState.mButtons[button] = false;
+		_queueEvent(InputEvent::ButtonReleased, button, 0, (std::uint64_t)di.dwTimeStamp * 1000000);
 		if(mBuffered && mListener)
 			return mListener->buttonReleased(JoyStickEvent(this, mState), button);
 	}
@@ -551,6 +568,7 @@ bool Win32JoyStick::_changePOV(int pov, DIDEVICEOBJECTDATA& di)
 		}
 	}
 
+	_queueEvent(InputEvent::PovMoved, pov, mState.mPOV[pov].direction, (std::uint64_t)di.dwTimeStamp * 1000000);
 	if(mBuffered && mListener)
 		return mListener->povMoved(JoyStickEvent(this, mState), pov);
 
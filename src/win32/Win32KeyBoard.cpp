@@ -99,6 +99,8 @@ void Win32Keyboard::capture()
 		_readBuffered();
 	else
 		_read();
+
+	_flushEvents();
 }
 
 //--------------------------------------------------------------------------------------------------//
@@ -131,8 +133,9 @@ void Win32Keyboard::_readBuffered()
 	{
 		//If the listener returns false, that means that we are probably deleted...
 		//send no more events and just leave as the this pointer is invalid now...
-		bool ret   = true;
-		KeyCode kc = (KeyCode)diBuff[i].dwOfs;
+		bool ret		   = true;
+		KeyCode kc		   = (KeyCode)diBuff[i].dwOfs;
+		std::uint64_t time = (std::uint64_t)diBuff[i].dwTimeStamp * 1000000;
 
 		//Store result in our keyBuffer too
 		KeyBuffer[kc] = static_cast<unsigned char>(diBuff[i].dwData);
@@ -190,8 +193,10 @@ void Win32Keyboard::_readBuffered()
 					mModifiers |= CapsLock;
 			}
 
+			int text = _translateText(kc);
+			_queueEvent(InputEvent::KeyPressed, kc, text, time);
 			if(mListener)
-				ret = mListener->keyPressed(KeyEvent(this, kc, _translateText(kc)));
+				ret = mListener->keyPressed(KeyEvent(this, kc, text));
 		}
 		else
 		{
@@ -238,6 +243,7 @@ void Win32Keyboard::_readBuffered()
 			}
 
 			//Fire off event
+			_queueEvent(InputEvent::KeyReleased, kc, 0, time);
 			if(mListener)
 				ret = mListener->keyReleased(KeyEvent(this, kc, 0));
 		}
@@ -262,11 +268,17 @@ void Win32Keyboard::_readBuffered()
 		{
 			if(keyBufferCopy[i] != KeyBuffer[i])
 			{
-				if(mListener)
+				if(KeyBuffer[i])
+				{
+					int text = _translateText((KeyCode)i);
+					_queueEvent(InputEvent::KeyPressed, i, text, 0);
+					if(mListener)
+						ret = mListener->keyPressed(KeyEvent(this, (KeyCode)i, text));
+				}
+				else
 				{
-					if(KeyBuffer[i])
-						ret = mListener->keyPressed(KeyEvent(this, (KeyCode)i, _translateText((KeyCode)i)));
-					else
+					_queueEvent(InputEvent::KeyReleased, i, 0, 0);
+					if(mListener)
 						ret = mListener->keyReleased(KeyEvent(this, (KeyCode)i, 0));
 				}
 			}
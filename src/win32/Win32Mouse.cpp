@@ -117,8 +117,23 @@ void Win32Mouse::capture()
 	mState.X.rel = mouseState.lX;
 	mState.Y.rel = mouseState.lY;
 	mState.Z.rel = mouseState.lZ;
+
+	//The device state has no timestamps, polled events are logged with 0
+	if(mouseState.lX != 0)
+		_queueEvent(InputEvent::MouseMoved, 0, mouseState.lX, 0);
+	if(mouseState.lY != 0)
+		_queueEvent(InputEvent::MouseMoved, 1, mouseState.lY, 0);
+	if(mouseState.lZ != 0)
+		_queueEvent(InputEvent::MouseMoved, 2, mouseState.lZ, 0);
+
 	for(unsigned int i = 0; i < 8; i++)
-		if(!_doMouseClick(i, mouseState.rgbButtons[i])) return;
+	{
+		if(!_doMouseClick(i, mouseState.rgbButtons[i]))
+		{
+			_flushEvents();
+			return;
+		}
+	}
 
 	bool axesMoved = mouseState.lX != 0 || mouseState.lY != 0 || mouseState.lZ != 0;
 
@@ -154,6 +169,8 @@ void Win32Mouse::capture()
 		if(mListener && mBuffered)
 			mListener->mouseMoved(MouseEvent(this, mState));
 	}
+
+	_flushEvents();
 }
 
 //--------------------------------------------------------------------------------------------------//
@@ -162,12 +179,14 @@ bool Win32Mouse::_doMouseClick(int mouseButton, unsigned char di)
 	if(di & 0x80 && !mState.buttonDown(MouseButtonID(mouseButton)))
 	{
 		mState.buttons |= 1 << mouseButton; //turn the bit flag on
+		_queueEvent(InputEvent::MousePressed, mouseButton, 0, 0);
 		if(mListener && mBuffered)
 			return mListener->mousePressed(MouseEvent(this, mState), MouseButtonID(mouseButton));
 	}
 	else if(!(di & 0x80) && mState.buttonDown(MouseButtonID(mouseButton)))
 	{
 		mState.buttons &= ~(1 << mouseButton); //turn the bit flag off
+		_queueEvent(InputEvent::MouseReleased, mouseButton, 0, 0);
 		if(mListener && mBuffered)
 			return mListener->mouseReleased(MouseEvent(this, mState), MouseButtonID(mouseButton));
 	}